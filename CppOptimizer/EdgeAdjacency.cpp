@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstdint>
+#include "EdgeAdjacency.h"
+#include "Profiler.h"
+
+using namespace std;
+
+void EdgeAdjacency::Build(const vector<int> &indices, const int vertexCount) {
+    PROFILE_SCOPE("BuildAdjacency");
+
+    const int triangleCount = (int) indices.size() / 3;
+
+    edgeStart_.assign(vertexCount + 1, 0);
+    edgeOther_.resize(triangleCount * 3);
+    edgeTriangle_.resize(triangleCount * 3);
+    nonManifoldEdges_.clear();
+
+    for (int i = 0; i < triangleCount * 3; i += 3) {
+        for (int k = 0; k < 3; k++) {
+            int u = indices[i + k], v = indices[i + (k + 1) % 3];
+            edgeStart_[min(u, v) + 1]++;
+        }
+    }
+
+    for (int i = 0; i < vertexCount; i++)
+        edgeStart_[i + 1] += edgeStart_[i];
+
+    //Entries are keyed by the highest vertex id, then the triangle id, so sorting a bucket once puts the uses of
+    //each edge next to each other with their triangles in ascending order.
+    vector<uint64_t> keys = vector<uint64_t>(triangleCount * 3);
+    vector<int> fill = vector<int>(edgeStart_.begin(), edgeStart_.end() - 1);
+    for (int i = 0; i < triangleCount * 3; i += 3) {
+        for (int k = 0; k < 3; k++) {
+            int u = indices[i + k], v = indices[i + (k + 1) % 3];
+            keys[fill[min(u, v)]++] = (uint64_t) max(u, v) << 32 | (uint32_t) (i / 3);
+        }
+    }
+
+    for (int u = 0; u < vertexCount; u++) {
+        sort(keys.begin() + edgeStart_[u], keys.begin() + edgeStart_[u + 1]);
+
+        for (int e = edgeStart_[u]; e < edgeStart_[u + 1]; e++) {
+            edgeOther_[e] = (int) (keys[e] >> 32);
+            edgeTriangle_[e] = (int) (uint32_t) keys[e];
+        }
+
+        for (int e = edgeStart_[u]; e < edgeStart_[u + 1]; e = EdgeEnd(u, e)) {
+            if (EdgeEnd(u, e) - e > 2)
+                nonManifoldEdges_.emplace_back(u, edgeOther_[e]);
+        }
+    }
+}
+
+int EdgeAdjacency::EdgeEnd(const int u, int e) const {
+    const int v = edgeOther_[e];
+    while (e < edgeStart_[u + 1] && edgeOther_[e] == v)
+        e++;
+    return e;
+}
+
+void EdgeAdjacency::CollectEdge(int u, int v, const int self, const int opposite,
+                                const vector<NavMeshTriangle> &triangles, vector<int> &out) const {
+    if (u > v)
+        swap(u, v);
+
+    const int *begin = edgeOther_.data() + edgeStart_[u], *end = edgeOther_.data() + edgeStart_[u + 1];
+    for (int e = (int) (lower_bound(begin, end, v) - edgeOther_.data()); e < edgeStart_[u + 1] && edgeOther_[e] == v;
+         e++) {
+        int t = edgeTriangle_[e];
+        if (t == self)
+            continue;
+
+        //Sharing all three vertices is a duplicate triangle, not a neighbor.
+        const NavMeshTriangle &other = triangles[t];
+        if (other.GetA() == opposite || other.GetB() == opposite || other.GetC() == opposite)
+            continue;
+
+        out.push_back(t);
+    }
+}
+
+void EdgeAdjacency::SetupNeighbors(vector<NavMeshTriangle> &triangles) const {
+    PROFILE_SCOPE("SetupNeighbors");
+
+    vector<int> neighbors = vector<int>();
+    neighbors.reserve(8);
+
+    for (int i = 0; i < (int) triangles.size(); i++) {
+        const int a = triangles[i].GetA(), b = triangles[i].GetB(), c = triangles[i].GetC();
+
+        neighbors.clear();
+        CollectEdge(a, b, i, c, triangles, neighbors);
+        CollectEdge(a, c, i, b, triangles, neighbors);
+        sort(neighbors.begin(), neighbors.end());
+
+        CollectEdge(b, c, i, a, triangles, neighbors);
+
+        triangles[i].SetNeighborIds(neighbors);
+    }
+}
+
+const vector<Vector2Int> &EdgeAdjacency::NonManifoldEdges() const {
+    return nonManifoldEdges_;
+}
+
+void EdgeAdjacency::BoundaryEdges(const vector<int> &indices, vector<Vector2Int> &edges,
+                                  vector<int> &edgeTriangles) const {
+    edges.clear();
+    edgeTriangles.clear();
+
+    for (int u = 0; u + 1 < (int) edgeStart_.size(); u++) {
+        for (int e = edgeStart_[u], next; e < edgeStart_[u + 1]; e = next) {
+            next = EdgeEnd(u, e);
+            if (next - e != 1)
+                continue;
+
+            const int v = edgeOther_[e];
+            const int t = edgeTriangle_[e];
+            bool forward = false;
+            for (int k = 0; k < 3; k++)
+                forward |= indices[t * 3 + k] == u && indices[t * 3 + (k + 1) % 3] == v;
+
+            edges.push_back(forward ? Vector2Int(u, v) : Vector2Int(v, u));
+            edgeTriangles.push_back(t);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef CPPOPTIMIZER_EDGEADJACENCY_H
+#define CPPOPTIMIZER_EDGEADJACENCY_H
+
+#include <vector>
+#include "NavMeshTriangle.h"
+#include "Vector2Int.h"
+
+using namespace std;
+
+/// <summary>
+///     Undirected edge table for a triangle list.
+///     Edges are bucketed by their lowest vertex id in flat arrays, each entry holding the highest vertex id and the
+///     triangle using the edge. Every bucket is sorted by the highest vertex id, so the uses of an edge form one
+///     run, and within the run the triangles are stored in ascending id order.
+/// </summary>
+class EdgeAdjacency {
+private:
+    vector<int> edgeStart_;
+    vector<int> edgeOther_, edgeTriangle_;
+
+    /// <summary>
+    ///     Edges (lowest vertex id, highest vertex id) shared by more than two triangles.
+    /// </summary>
+    vector<Vector2Int> nonManifoldEdges_;
+
+    /// <summary>
+    ///     End of the run of entries in the bucket of u that hold the same edge as entry e.
+    /// </summary>
+    int EdgeEnd(int u, int e) const;
+
+    void CollectEdge(int u, int v, int self, int opposite, const vector<NavMeshTriangle> &triangles,
+                     vector<int> &out) const;
+
+public:
+    void Build(const vector<int> &indices, int vertexCount);
+
+    /// <summary>
+    ///     Sets the neighbors of every triangle in a single pass over the edge table. Neighbors are triangles
+    ///     sharing exactly two vertices, ordered as those sharing the first vertex followed by those sharing the
+    ///     edge opposite of it, each group in ascending id order.
+    ///     Expects triangles without repeated vertices, as produced by VertexWeld.
+    /// </summary>
+    void SetupNeighbors(vector<NavMeshTriangle> &triangles) const;
+
+    const vector<Vector2Int> &NonManifoldEdges() const;
+
+    /// <summary>
+    ///     Lists the edges used by a single triangle, directed as they run in that triangle, along with the triangle.
+    ///     Edges are in order of their lowest vertex id, then their highest.
+    /// </summary>
+    void BoundaryEdges(const vector<int> &indices, vector<Vector2Int> &edges, vector<int> &edgeTriangles) const;
+};
+
+
+#endif //CPPOPTIMIZER_EDGEADJACENCY_H
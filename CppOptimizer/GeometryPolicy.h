@@ -0,0 +1,46 @@
+#ifndef CPPOPTIMIZER_GEOMETRYPOLICY_H
+#define CPPOPTIMIZER_GEOMETRYPOLICY_H
+
+using namespace std;
+
+/// <summary>
+///     Compile time settings of the geometry tests and the optimizer, shared by the pipeline, the benchmarks and the
+///     pathfinder. Only the barycentric weights of the triangle locator and the optional margin of
+///     MathC::PointWithinTriangle2D are computed in Scalar. The mesh, the weld, the grids, the hole filler, the
+///     decimator and the pathfinder stay float whatever T is, as do the constants typed float here.
+/// </summary>
+template<typename T>
+struct GeometryPolicy {
+    typedef T Scalar;
+
+    ///<summary>Cell size of the triangle groups, also the range of the hole filling grid.</summary>
+    static constexpr float groupSize = 5.0f;
+
+    ///<summary>Vertices closer than this are welded.</summary>
+    static constexpr float overlapCheckDistance = 0.3f;
+
+    ///<summary>Barycentric slack of the triangle locator, so points on a shared or boundary edge are found.</summary>
+    static constexpr T locateTolerance = T(0.0001);
+
+    ///<summary>Largest height and outline change at any input vertex when the mesh is decimated.</summary>
+    static constexpr float decimationError = 0.05f;
+
+    ///<summary>Average triangle count the path hierarchy grows its clusters to.</summary>
+    static constexpr int clusterTriangles = 32;
+};
+
+typedef GeometryPolicy<float> FloatPolicy;
+typedef GeometryPolicy<double> DoublePolicy;
+
+/// <summary>
+///     Policy of this build. CPPOPTIMIZER_DOUBLE_PRECISION computes the triangle locator and the point margins in
+///     double. It does not make the optimizer fit for coordinates too large for float.
+/// </summary>
+#ifdef CPPOPTIMIZER_DOUBLE_PRECISION
+typedef DoublePolicy DefaultPolicy;
+#else
+typedef FloatPolicy DefaultPolicy;
+#endif
+
+
+#endif //CPPOPTIMIZER_GEOMETRYPOLICY_H
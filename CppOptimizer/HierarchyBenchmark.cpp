@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GeometryPolicy.h"
+#include "NavMeshJsonReader.h"
+#include "NavMeshOptimizer.h"
+#include "NavMeshPathfinder.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+/// <summary>
+///     Random point on a random triangle of the mesh.
+/// </summary>
+static Vector3 RandomPoint(const NavMeshData &mesh, mt19937 &random) {
+    uniform_int_distribution<int> triangle = uniform_int_distribution<int>(0, mesh.TriangleCount() - 1);
+    uniform_real_distribution<float> weight = uniform_real_distribution<float>(0.0f, 1.0f);
+
+    const int t = triangle(random);
+    float u = weight(random), v = weight(random);
+    if (u + v > 1.0f) {
+        u = 1.0f - u;
+        v = 1.0f - v;
+    }
+
+    const int a = mesh.indices[t * 3], b = mesh.indices[t * 3 + 1], c = mesh.indices[t * 3 + 2];
+    return {mesh.x[a] + u * (mesh.x[b] - mesh.x[a]) + v * (mesh.x[c] - mesh.x[a]),
+            mesh.y[a] + u * (mesh.y[b] - mesh.y[a]) + v * (mesh.y[c] - mesh.y[a]),
+            mesh.z[a] + u * (mesh.z[b] - mesh.z[a]) + v * (mesh.z[c] - mesh.z[a])};
+}
+
+static double PathLength(const vector<Vector3> &path) {
+    double length = 0;
+    for (int i = 1; i < (int) path.size(); i++)
+        length += Vector3::Distance(path[i - 1], path[i]);
+    return length;
+}
+
+/// <summary>
+///     Times random path queries on the L meshes from the given json folder with the triangle A* and through the
+///     cluster hierarchy OptimizeNavMesh builds, on a single thread. Only queries between different clusters use
+///     the hierarchy, so the long queries, the quarter of requests with the farthest apart ends, are reported on
+///     their own as well. Both must find the same paths up to ties, the mean lengths show it, and a path found
+///     by only one of them is counted as a mismatch, which gives a non zero exit code.
+/// </summary>
+int main(int argc, char *argv[]) {
+    const int requestCount = 20000, repeatCount = 5;
+
+    if (argc < 2) {
+        cout << "Usage: HierarchyBenchmark <json folder>\n";
+        return 1;
+    }
+
+    const fs::path folder = argv[1];
+    int mismatches = 0;
+
+    cout << "Mesh, Triangles, Clusters, Entrances, Build ms, Queries, A* us, Hierarchy us, Speedup, "
+            "A* length, Hierarchy length\n";
+    for (int number = 1; number <= 5; number++) {
+        const string name = "L " + to_string(number);
+
+        NavMeshImport navMeshImport = NavMeshJsonReader::Load(folder / (name + ".json"));
+        NavMeshData input = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+        const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0], navMeshImport.getCleanPoint()[1],
+                                           navMeshImport.getCleanPoint()[2]);
+
+        NavMeshOptimized optimized = OptimizeNavMesh(cleanPoint, input, nullptr);
+        const NavMeshData &mesh = optimized.getMesh();
+
+        //Built again only to time it, the pathfinder uses the one from the optimized mesh.
+        NavMeshHierarchy rebuilt = NavMeshHierarchy();
+        auto buildStart = high_resolution_clock::now();
+        rebuilt.Build(mesh, DefaultPolicy::groupSize, DefaultPolicy::clusterTriangles);
+        const double buildMilliseconds = duration<double, milli>(high_resolution_clock::now() - buildStart).count();
+
+        const NavMeshPathfinder flat = NavMeshPathfinder(mesh);
+        const NavMeshPathfinder hierarchical = NavMeshPathfinder(mesh, DefaultPolicy::groupSize,
+                                                                 &optimized.getHierarchy());
+
+        mt19937 random = mt19937(number);
+        vector<Vector3> starts = vector<Vector3>(), goals = vector<Vector3>();
+        for (int i = 0; i < requestCount; i++) {
+            starts.push_back(RandomPoint(mesh, random));
+            goals.push_back(RandomPoint(mesh, random));
+        }
+
+        vector<double> distances = vector<double>();
+        for (int i = 0; i < requestCount; i++)
+            distances.push_back(Vector3::Distance(starts[i], goals[i]));
+        vector<double> sorted = distances;
+        nth_element(sorted.begin(), sorted.begin() + requestCount * 3 / 4, sorted.end());
+        const double longDistance = sorted[requestCount * 3 / 4];
+
+        for (const bool longOnly: {false, true}) {
+            NavMeshPathQuery query = NavMeshPathQuery();
+            vector<Vector3> path = vector<Vector3>();
+
+            double flatSeconds = 0, hierarchySeconds = 0, flatLength = 0, hierarchyLength = 0;
+            int queries = 0;
+            for (int i = 0; i < requestCount; i++) {
+                if (longOnly && distances[i] < longDistance)
+                    continue;
+
+                queries++;
+                bool flatFound = false, hierarchyFound = false;
+                for (int repeat = 0; repeat < repeatCount; repeat++) {
+                    auto timerStart = high_resolution_clock::now();
+                    flatFound = flat.FindPath(starts[i], goals[i], query, path);
+                    flatSeconds += duration<double>(high_resolution_clock::now() - timerStart).count();
+                }
+                flatLength += PathLength(path);
+
+                for (int repeat = 0; repeat < repeatCount; repeat++) {
+                    auto timerStart = high_resolution_clock::now();
+                    hierarchyFound = hierarchical.FindPath(starts[i], goals[i], query, path);
+                    hierarchySeconds += duration<double>(high_resolution_clock::now() - timerStart).count();
+                }
+                hierarchyLength += PathLength(path);
+
+                mismatches += flatFound != hierarchyFound;
+            }
+
+            const double flatMicroseconds = flatSeconds * 1e6 / (queries * (double) repeatCount),
+                    hierarchyMicroseconds = hierarchySeconds * 1e6 / (queries * (double) repeatCount);
+
+            cout << name << (longOnly ? " long" : "") << ", " << mesh.TriangleCount() << ", "
+                 << optimized.getHierarchy().ClusterCount() << ", " << optimized.getHierarchy().Entrances().size()
+                 << ", " << buildMilliseconds << ", " << queries << ", " << flatMicroseconds << ", "
+                 << hierarchyMicroseconds << ", " << flatMicroseconds / hierarchyMicroseconds << ", "
+                 << flatLength / queries << ", " << hierarchyLength / queries << "\n";
+        }
+    }
+
+    cout << "Mismatches: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
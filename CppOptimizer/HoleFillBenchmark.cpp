@@ -0,0 +1,96 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "EdgeAdjacency.h"
+#include "GeometryPolicy.h"
+#include "HoleFiller.h"
+#include "NavMeshJsonReader.h"
+#include "NavMeshOptimizer.h"
+#include "VertexWeld.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+/// <summary>
+///     Compares the hole filling modes on every mesh of the given json folder. Each mode runs on the welded and
+///     connected mesh OptimizeNavMesh hands to it, and reports the average time, the triangles it added and the
+///     boundary edges left open afterwards, which for a watertight result are only the outer boundary and the
+///     obstacles.
+/// </summary>
+int main(int argc, char *argv[]) {
+    const int repeatCount = 20;
+
+    if (argc < 2) {
+        cout << "Usage: HoleFillBenchmark <json folder>\n";
+        return 1;
+    }
+
+    const fs::path folder = argv[1];
+
+    cout << "Mesh, Mode, Milliseconds, Speedup, Triangles added, Open edges, Triangles\n";
+    for (const string letter: {"S", "M", "L"}) {
+        for (int number = 1; number <= 5; number++) {
+            const string name = letter + " " + to_string(number);
+
+            NavMeshImport navMeshImport = NavMeshJsonReader::Load(folder / (name + ".json"));
+            const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0], navMeshImport.getCleanPoint()[1],
+                                               navMeshImport.getCleanPoint()[2]);
+
+            NavMeshData welded = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+            VertexWeld::Weld(welded, DefaultPolicy::overlapCheckDistance);
+
+            pmr::map<int, pmr::vector<int>> trianglesByVertexId = pmr::map<int, pmr::vector<int>>();
+            for (int i = 0; i < welded.VertexCount(); i++)
+                trianglesByVertexId.insert({i, pmr::vector<int>()});
+            SetupNavTriangles(welded, trianglesByVertexId);
+
+            EdgeAdjacency adjacency = EdgeAdjacency();
+            adjacency.Build(welded.indices, welded.VertexCount());
+            adjacency.SetupNeighbors(welded.triangles);
+
+            vector<int> islandSizes = vector<int>(), keptIslands = vector<int>();
+            const vector<int> connected = KeepConnected(cleanPoint, welded, trianglesByVertexId, 0, islandSizes,
+                                                        keptIslands);
+            const NavMeshData extracted = welded.Extract(connected);
+
+            double baseline = 0;
+            for (const HoleFillMode mode: {HoleFillMode::Candidates, HoleFillMode::BoundaryLoops}) {
+                NavMeshData mesh = NavMeshData();
+
+                double milliseconds = 0;
+                for (int repeat = 0; repeat < repeatCount; repeat++) {
+                    mesh = extracted;
+
+                    auto timerStart = high_resolution_clock::now();
+                    if (mode == HoleFillMode::BoundaryLoops)
+                        HoleFiller::FillHoleLoops(mesh, DefaultPolicy::overlapCheckDistance);
+                    else
+                        HoleFiller::FillHoles(mesh, DefaultPolicy::groupSize);
+                    milliseconds += duration<double, milli>(high_resolution_clock::now() - timerStart).count();
+                }
+                milliseconds /= repeatCount;
+
+                if (mode == HoleFillMode::Candidates)
+                    baseline = milliseconds;
+
+                adjacency.Build(mesh.indices, mesh.VertexCount());
+                vector<Vector2Int> openEdges = vector<Vector2Int>();
+                vector<int> openEdgeTriangles = vector<int>();
+                adjacency.BoundaryEdges(mesh.indices, openEdges, openEdgeTriangles);
+
+                cout << name << ", " << (mode == HoleFillMode::BoundaryLoops ? "boundary loops" : "candidates")
+                     << ", " << milliseconds << ", " << baseline / milliseconds << ", "
+                     << mesh.TriangleCount() - extracted.TriangleCount() << ", " << openEdges.size() << ", "
+                     << mesh.TriangleCount() << "\n";
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,548 @@
+#include <algorithm>
+#include <unordered_set>
+#include "EdgeAdjacency.h"
+#include "HoleFiller.h"
+#include "Predicates.h"
+#include "Profiler.h"
+
+using namespace std;
+
+struct TriangleKeyHash {
+    size_t operator()(const array<int, 3> &key) const {
+        return ((size_t) key[0] * 73856093u) ^ ((size_t) key[1] * 19349663u) ^ ((size_t) key[2] * 83492791u);
+    }
+};
+
+/// Order in which each corner of a triangle records the other two corners as connections.
+static const int firstConnection[3] = {1, 0, 1}, secondConnection[3] = {2, 2, 0};
+
+static array<int, 3> TriangleKey(int a, int b, int c) {
+    array<int, 3> key = {a, b, c};
+    sort(key.begin(), key.end());
+    return key;
+}
+
+/// <summary>
+///     Bounds of the triangle in the XZ plane, padded by HoleFiller::boundsPadding by the callers.
+/// </summary>
+static void TriangleBounds(const NavMeshData &mesh, const int t, float &minX, float &minZ, float &maxX, float &maxZ) {
+    const int a = mesh.indices[t * 3], b = mesh.indices[t * 3 + 1], c = mesh.indices[t * 3 + 2];
+
+    minX = MathC::Min(MathC::Min(mesh.x[a], mesh.x[b]), mesh.x[c]);
+    minZ = MathC::Min(MathC::Min(mesh.z[a], mesh.z[b]), mesh.z[c]);
+    maxX = MathC::Max(MathC::Max(mesh.x[a], mesh.x[b]), mesh.x[c]);
+    maxZ = MathC::Max(MathC::Max(mesh.z[a], mesh.z[b]), mesh.z[c]);
+}
+
+void HoleFiller::InsertTriangle(UniformGrid &grid, const NavMeshData &mesh, const int t) {
+    float minX, minZ, maxX, maxZ;
+    TriangleBounds(mesh, t, minX, minZ, maxX, maxZ);
+    grid.Insert(t, minX - boundsPadding, minZ - boundsPadding, maxX + boundsPadding, maxZ + boundsPadding);
+}
+
+void HoleFiller::RemoveTriangle(UniformGrid &grid, const NavMeshData &mesh, const int t) {
+    float minX, minZ, maxX, maxZ;
+    TriangleBounds(mesh, t, minX, minZ, maxX, maxZ);
+    grid.Remove(t, minX - boundsPadding, minZ - boundsPadding, maxX + boundsPadding, maxZ + boundsPadding);
+}
+
+void HoleFiller::ReinsertTriangle(UniformGrid &grid, const NavMeshData &mesh, const int t) {
+    float minX, minZ, maxX, maxZ;
+    TriangleBounds(mesh, t, minX, minZ, maxX, maxZ);
+    grid.InsertOrdered(t, minX - boundsPadding, minZ - boundsPadding, maxX + boundsPadding, maxZ + boundsPadding);
+}
+
+void HoleFiller::ResetGrid(UniformGrid &grid, const NavMeshData &mesh, const float cellSize) {
+    float minX = mesh.x[0], minZ = mesh.z[0], maxX = mesh.x[0], maxZ = mesh.z[0];
+    for (int i = 1; i < mesh.VertexCount(); i++) {
+        minX = MathC::Min(minX, mesh.x[i]);
+        minZ = MathC::Min(minZ, mesh.z[i]);
+        maxX = MathC::Max(maxX, mesh.x[i]);
+        maxZ = MathC::Max(maxZ, mesh.z[i]);
+    }
+
+    grid.Reset(minX - boundsPadding, minZ - boundsPadding, maxX + boundsPadding, maxZ + boundsPadding,
+               cellSize, (int) mesh.indices.size());
+}
+
+void HoleFiller::BuildGrid(UniformGrid &grid, const NavMeshData &mesh, const float cellSize) {
+    ResetGrid(grid, mesh, cellSize);
+
+    for (int t = 0; t < mesh.TriangleCount(); t++)
+        InsertTriangle(grid, mesh, t);
+}
+
+void HoleFiller::BuildConnections(const NavMeshData &mesh, pmr::vector<pmr::vector<int>> &connectionsByIndex) {
+    const vector<int> &indices = mesh.indices;
+
+    //The lists use the resource of the outer list.
+    connectionsByIndex.clear();
+    connectionsByIndex.resize(mesh.VertexCount());
+    for (pmr::vector<int> &connections: connectionsByIndex)
+        connections.reserve(16);
+
+    for (int i = 0; i < (int) indices.size(); i += 3) {
+        //The lookups only consider the connections known before this triangle, as a new connection can only be
+        //added once per triangle.
+        for (int k = 0; k < 3; k++) {
+            pmr::vector<int> &connections = connectionsByIndex[indices[i + k]];
+            const auto known = connections.end();
+            int first = indices[i + firstConnection[k]],
+                    second = indices[i + secondConnection[k]];
+
+            bool addFirst = find(connections.begin(), known, first) == known,
+                    addSecond = find(connections.begin(), known, second) == known;
+
+            if (addFirst)
+                connections.push_back(first);
+            if (addSecond)
+                connections.push_back(second);
+        }
+
+        for (int k = 0; k < 3; k++)
+            connectionsByIndex[indices[i + k]].insert(connectionsByIndex[indices[i + k]].end(),
+                                                      indices.begin() + i, indices.begin() + i + 3);
+    }
+}
+
+bool HoleFiller::PushVertex(NavMeshData &mesh, const UniformGrid &grid, const int i, const bool apply,
+                            Scratch &scratch) {
+    const vector<int> &indices = mesh.indices;
+    Vector2 p = mesh.XZ(i);
+
+    Vector2Int cell = grid.CellOf(p.x, p.y);
+    scratch.cellTriangles.clear();
+    scratch.overlapping.Clear();
+    for (int e = grid.Head(cell.x, cell.y); e != -1; e = grid.Next(e)) {
+        int j = grid.Item(e) * 3;
+
+        if (indices[j] == i || indices[j + 1] == i || indices[j + 2] == i)
+            continue;
+
+        scratch.cellTriangles.push_back(j);
+        scratch.overlapping.Add(mesh.XZ(indices[j]), mesh.XZ(indices[j + 1]), mesh.XZ(indices[j + 2]));
+    }
+
+    scratch.hits.assign(scratch.overlapping.Size(), 0);
+    MathC::PointWithinTriangles2DWithTolerance(p, scratch.overlapping, scratch.hits);
+
+    bool within = find(scratch.hits.begin(), scratch.hits.end(), 1) != scratch.hits.end();
+    if (!within || !apply)
+        return within;
+
+    for (int h = 0; h < (int) scratch.hits.size(); h++) {
+        if (!scratch.hits[h])
+            continue;
+
+        int j = scratch.cellTriangles[h];
+        Vector2 a = mesh.XZ(indices[j]),
+                b = mesh.XZ(indices[j + 1]),
+                c = mesh.XZ(indices[j + 2]);
+
+        Vector2 close1 = MathC::ClosetPointOnLine(p, a, b),
+                close2 = MathC::ClosetPointOnLine(p, a, c),
+                close3 = MathC::ClosetPointOnLine(p, b, b);
+
+        Vector2 close = close3;
+        if (Vector2::Distance(close1, p) < Vector2::Distance(close2, p) &&
+            Vector2::Distance(close1, p) < Vector2::Distance(close3, p))
+            close = close1;
+        else if (Vector2::Distance(close2, p) < Vector2::Distance(close3, p))
+            close = close2;
+
+        Vector2 offset = close - p;
+        float mag = offset.Magnitude() + 0.01f;
+        offset.NormalizeSelf();
+        Vector2 moved = offset * mag;
+        Vector3 o = MathC::XYZ(moved);
+        Vector3 vertex = mesh.Vertex(i);
+        mesh.SetVertex(i, vertex + o);
+    }
+
+    return true;
+}
+
+bool HoleFiller::Overlaps(const NavMeshData &mesh, const UniformGrid &grid, const array<int, 3> &candidate,
+                          Scratch &scratch) {
+    const vector<int> &indices = mesh.indices;
+
+    Vector2 a = mesh.XZ(candidate[0]),
+            b = mesh.XZ(candidate[1]),
+            c = mesh.XZ(candidate[2]);
+
+    Vector2 center = Vector2::Lerp(Vector2::Lerp(a, b, .5f), c, .5f);
+
+    float minX = MathC::Min(MathC::Min(a.x, b.x), c.x),
+            minY = MathC::Min(MathC::Min(a.y, b.y), c.y),
+            maxX = MathC::Max(MathC::Max(a.x, b.x), c.x),
+            maxY = MathC::Max(MathC::Max(a.y, b.y), c.y);
+
+    if ((int) scratch.visited.size() < mesh.TriangleCount())
+        scratch.visited.resize(mesh.TriangleCount(), -1);
+
+    scratch.query++;
+    scratch.overlapping.Clear();
+    Vector2Int from = grid.CellOf(minX, minY), to = grid.CellOf(maxX, maxY);
+
+    for (int cellZ = from.y; cellZ <= to.y; cellZ++) {
+        for (int cellX = from.x; cellX <= to.x; cellX++) {
+            for (int e = grid.Head(cellX, cellZ); e != -1; e = grid.Next(e)) {
+                int t = grid.Item(e);
+                if (scratch.visited[t] == scratch.query)
+                    continue;
+                scratch.visited[t] = scratch.query;
+
+                Vector2 aP = mesh.XZ(indices[t * 3]),
+                        bP = mesh.XZ(indices[t * 3 + 1]),
+                        cP = mesh.XZ(indices[t * 3 + 2]);
+
+                //Bounding
+                if (maxX < MathC::Min(MathC::Min(aP.x, bP.x), cP.x))
+                    continue;
+                if (maxY < MathC::Min(MathC::Min(aP.y, bP.y), cP.y))
+                    continue;
+                if (minX > MathC::Max(MathC::Max(aP.x, bP.x), cP.x))
+                    continue;
+                if (minY > MathC::Max(MathC::Max(aP.y, bP.y), cP.y))
+                    continue;
+
+                scratch.overlapping.Add(aP, bP, cP);
+            }
+        }
+    }
+
+    //One of the new triangle points is within an already existing triangle, or the edges cross
+    scratch.hits.assign(scratch.overlapping.Size(), 0);
+    MathC::PointWithinTriangles2DWithTolerance(center, scratch.overlapping, scratch.hits);
+    MathC::PointWithinTriangles2DWithTolerance(a, scratch.overlapping, scratch.hits);
+    MathC::PointWithinTriangles2DWithTolerance(b, scratch.overlapping, scratch.hits);
+    MathC::PointWithinTriangles2DWithTolerance(c, scratch.overlapping, scratch.hits);
+
+    if (find(scratch.hits.begin(), scratch.hits.end(), 1) != scratch.hits.end())
+        return true;
+
+    MathC::TriangleIntersects2DWithTolerance(a, b, c, scratch.overlapping, scratch.hits);
+    return find(scratch.hits.begin(), scratch.hits.end(), 1) != scratch.hits.end();
+}
+
+void HoleFiller::FillHoles(NavMeshData &mesh, const float cellSize, ThreadPool *pool, const int firstFreeVertex,
+                           pmr::memory_resource *memory) {
+    PROFILE_SCOPE("FillHoles");
+
+    if (mesh.VertexCount() == 0)
+        return;
+
+    vector<int> &indices = mesh.indices;
+    const int vertexCount = mesh.VertexCount();
+
+    pmr::vector<pmr::vector<int>> connectionsByIndex = pmr::vector<pmr::vector<int>>(memory);
+    BuildConnections(mesh, connectionsByIndex);
+
+    vector<Scratch> scratch = vector<Scratch>(pool == nullptr ? 1 : pool->ThreadCount());
+
+    UniformGrid grid = UniformGrid();
+    BuildGrid(grid, mesh, cellSize);
+
+#pragma region Push vertices out of overlapped triangles
+
+    //Vertices before the first one that needs a push see the unmodified mesh in the serial order as well, so only
+    //the vertices from there on are replayed serially.
+    const int firstFree = min(firstFreeVertex, vertexCount);
+    pmr::vector<uint8_t> within = pmr::vector<uint8_t>(vertexCount, 0, memory);
+    ThreadPool::ParallelFor(pool, vertexCount - firstFree, 64, [&](int begin, int end, int worker) {
+        for (int i = firstFree + begin; i < firstFree + end; i++)
+            within[i] = PushVertex(mesh, grid, i, false, scratch[worker]);
+    });
+
+    int firstWithin = (int) (find(within.begin(), within.end(), 1) - within.begin());
+    if (firstWithin < vertexCount) {
+        //Triangles around each vertex, as offsets into a single list. A vertex repeated in a degenerate triangle
+        //lists it once, so it is not inserted twice.
+        auto firstCorner = [&](const int i) {
+            const int t = i - i % 3;
+            return !(i > t && indices[t] == indices[i]) && !(i == t + 2 && indices[t + 1] == indices[i]);
+        };
+
+        pmr::vector<int> fanStart = pmr::vector<int>(vertexCount + 1, 0, memory);
+        for (int i = 0; i < (int) indices.size(); i++)
+            fanStart[indices[i] + 1] += firstCorner(i);
+        for (int v = 0; v < vertexCount; v++)
+            fanStart[v + 1] += fanStart[v];
+
+        pmr::vector<int> fanTriangles = pmr::vector<int>(fanStart[vertexCount], memory),
+                fill = pmr::vector<int>(fanStart.begin(), fanStart.end() - 1, memory);
+        for (int i = 0; i < (int) indices.size(); i++) {
+            if (firstCorner(i))
+                fanTriangles[fill[indices[i]]++] = i / 3;
+        }
+
+        for (int i = firstWithin; i < vertexCount; i++) {
+            if (!PushVertex(mesh, grid, i, false, scratch[0]))
+                continue;
+
+            //A moved vertex only changes the bounds of the triangles using it.
+            for (int f = fanStart[i]; f < fanStart[i + 1]; f++)
+                RemoveTriangle(grid, mesh, fanTriangles[f]);
+
+            PushVertex(mesh, grid, i, true, scratch[0]);
+
+            for (int f = fanStart[i]; f < fanStart[i + 1]; f++)
+                ReinsertTriangle(grid, mesh, fanTriangles[f]);
+        }
+    }
+
+#pragma endregion
+
+#pragma region Collect candidate triangles
+
+    //Candidates are listed in the serial search order. A candidate seen before is skipped as it was either
+    //accepted, and now exists, or denied, and more triangles can only deny it again.
+    pmr::unordered_set<array<int, 3>, TriangleKeyHash> existing =
+            pmr::unordered_set<array<int, 3>, TriangleKeyHash>(memory);
+    existing.reserve(indices.size());
+    for (int i = 0; i < (int) indices.size(); i += 3)
+        existing.insert(TriangleKey(indices[i], indices[i + 1], indices[i + 2]));
+
+    pmr::vector<array<int, 3>> candidates = pmr::vector<array<int, 3>>(memory);
+
+    for (int original = 0; original < vertexCount; original++) {
+        const pmr::vector<int> &originalConnections = connectionsByIndex[original];
+        int s = (int) originalConnections.size();
+
+        for (int otherIndex = 0; otherIndex < s; otherIndex++) {
+            int other = originalConnections[otherIndex];
+
+            if (other <= original)
+                continue;
+
+            for (int finalIndex = otherIndex + 1; finalIndex < s; finalIndex++) {
+                int final = originalConnections[finalIndex];
+
+                if (final <= original || final <= other || final < firstFree)
+                    continue;
+
+                const pmr::vector<int> &v = connectionsByIndex[final];
+                if (find(v.begin(), v.end(), other) == v.end())
+                    continue;
+
+                //The triangle already exists
+                if (!existing.insert({original, other, final}).second)
+                    continue;
+
+                candidates.push_back({original, other, final});
+            }
+        }
+    }
+
+#pragma endregion
+
+#pragma region Test candidates and merge in order
+
+    pmr::vector<uint8_t> denied = pmr::vector<uint8_t>(candidates.size(), 0, memory);
+    ThreadPool::ParallelFor(pool, (int) candidates.size(), 32, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; i++)
+            denied[i] = Overlaps(mesh, grid, candidates[i], scratch[worker]);
+    });
+
+    //Accepted triangles only have to be tested against the triangles accepted before them.
+    UniformGrid added = UniformGrid();
+    ResetGrid(added, mesh, cellSize);
+
+    [[maybe_unused]] const int trianglesBefore = mesh.TriangleCount();
+    for (int i = 0; i < (int) candidates.size(); i++) {
+        if (denied[i] || Overlaps(mesh, added, candidates[i], scratch[0]))
+            continue;
+
+        indices.insert(indices.end(), candidates[i].begin(), candidates[i].end());
+        InsertTriangle(added, mesh, mesh.TriangleCount() - 1);
+    }
+
+    PROFILE_COUNT("Candidate triangles tested", candidates.size());
+    PROFILE_COUNT("Candidate triangles accepted", mesh.TriangleCount() - trianglesBefore);
+
+#pragma endregion
+}
+
+bool HoleFiller::ClipEars(const NavMeshData &mesh, pmr::vector<int> &ring, const double winding,
+                          pmr::vector<int> &out) {
+    int i = 0, misses = 0;
+    while (ring.size() > 3) {
+        const int n = (int) ring.size();
+        if (misses >= n)
+            return false;
+
+        i %= n;
+        const int prev = ring[(i + n - 1) % n], current = ring[i], next = ring[(i + 1) % n];
+        const Vector2 a = mesh.XZ(prev), b = mesh.XZ(current), c = mesh.XZ(next);
+        const double orientation = Predicates::Orient2D(a, b, c);
+
+        bool ear = orientation * winding >= 0;
+        if (ear && orientation == 0) {
+            //A collinear ear is the zero area stitch of a T-junction, only valid when the vertex is between both.
+            ear = ((double) a.x - b.x) * ((double) c.x - b.x) + ((double) a.y - b.y) * ((double) c.y - b.y) < 0;
+        } else if (ear) {
+            for (int k = 0; k < n && ear; k++) {
+                if (k == i || k == (i + 1) % n || k == (i + n - 1) % n)
+                    continue;
+
+                const Vector2 point = mesh.XZ(ring[k]);
+                ear = Predicates::Orient2D(a, b, point) * winding < 0 ||
+                      Predicates::Orient2D(b, c, point) * winding < 0 ||
+                      Predicates::Orient2D(c, a, point) * winding < 0;
+            }
+        }
+
+        if (!ear) {
+            i++;
+            misses++;
+            continue;
+        }
+
+        out.insert(out.end(), {prev, current, next});
+        ring.erase(ring.begin() + i);
+        misses = 0;
+
+        //Clipping may turn the previous vertex into an ear.
+        i = i > 0 ? i - 1 : 0;
+    }
+
+    if (Predicates::Orient2D(mesh.XZ(ring[0]), mesh.XZ(ring[1]), mesh.XZ(ring[2])) * winding < 0)
+        return false;
+
+    out.insert(out.end(), ring.begin(), ring.end());
+    return true;
+}
+
+void HoleFiller::FillHoleLoops(NavMeshData &mesh, const float maxWidth, const int firstFreeVertex,
+                               pmr::memory_resource *memory, const vector<int> *triangleTile) {
+    PROFILE_SCOPE("FillHoleLoops");
+
+    const int vertexCount = mesh.VertexCount();
+
+    EdgeAdjacency adjacency = EdgeAdjacency();
+    adjacency.Build(mesh.indices, vertexCount);
+
+    vector<Vector2Int> edges = vector<Vector2Int>();
+    vector<int> edgeTriangles = vector<int>();
+    adjacency.BoundaryEdges(mesh.indices, edges, edgeTriangles);
+
+#pragma region Steps along the boundary per vertex
+
+    //Loops run against the winding of the triangles they bound, so the boundary edge (u, v) is the step from v to u.
+    pmr::vector<int> stepStart = pmr::vector<int>(vertexCount + 1, 0, memory);
+    for (const Vector2Int &edge: edges)
+        stepStart[edge.y + 1]++;
+
+    for (int i = 0; i < vertexCount; i++)
+        stepStart[i + 1] += stepStart[i];
+
+    pmr::vector<int> stepCursor = pmr::vector<int>(stepStart.begin(), stepStart.end() - 1, memory);
+    pmr::vector<int> steps = pmr::vector<int>(edges.size(), memory);
+    for (int e = 0; e < (int) edges.size(); e++)
+        steps[stepCursor[edges[e].y]++] = e;
+
+    copy(stepStart.begin(), stepStart.end() - 1, stepCursor.begin());
+    pmr::vector<uint8_t> used = pmr::vector<uint8_t>(edges.size(), 0, memory);
+
+    auto nextStep = [&](const int v) {
+        while (stepCursor[v] < stepStart[v + 1] && used[steps[stepCursor[v]]])
+            stepCursor[v]++;
+        return stepCursor[v] < stepStart[v + 1] ? steps[stepCursor[v]] : -1;
+    };
+
+#pragma endregion
+
+#pragma region Trace simple loops and close the narrow ones
+
+    //Tile of the triangles around every vertex, or -1 when they lie in several tiles.
+    pmr::vector<int> vertexTile = pmr::vector<int>(memory);
+    if (triangleTile != nullptr) {
+        vertexTile.assign(vertexCount, -2);
+        for (int i = 0; i < (int) mesh.indices.size(); i++) {
+            int &tile = vertexTile[mesh.indices[i]];
+            tile = tile == -2 || tile == (*triangleTile)[i / 3] ? (*triangleTile)[i / 3] : -1;
+        }
+    }
+
+    pmr::vector<int> path = pmr::vector<int>(memory), pathEdges = pmr::vector<int>(memory);
+    pmr::vector<int> onPath = pmr::vector<int>(vertexCount, -1, memory);
+    pmr::vector<int> ring = pmr::vector<int>(memory), added = pmr::vector<int>(memory);
+
+    [[maybe_unused]] int loopCount = 0;
+    [[maybe_unused]] const int trianglesBefore = mesh.TriangleCount();
+
+    auto closeLoop = [&](const int first) {
+        loopCount++;
+
+        bool touchesFree = false, spansTiles = triangleTile == nullptr;
+        double area = 0, perimeter = 0, winding = 0;
+        for (int k = first; k < (int) path.size(); k++) {
+            const Vector2 a = mesh.XZ(path[k]), b = mesh.XZ(path[k + 1 < (int) path.size() ? k + 1 : first]);
+            area += ((double) a.x * b.y - (double) b.x * a.y) / 2;
+            perimeter += sqrt(((double) b.x - a.x) * ((double) b.x - a.x) +
+                              ((double) b.y - a.y) * ((double) b.y - a.y));
+            touchesFree |= path[k] >= firstFreeVertex;
+            spansTiles |= triangleTile != nullptr &&
+                          (vertexTile[path[k]] == -1 || vertexTile[path[k]] != vertexTile[path[first]]);
+
+            //The winding of the first triangle along the loop that is not degenerate.
+            if (winding == 0) {
+                const int t = edgeTriangles[pathEdges[k]];
+                winding = Predicates::Orient2D(mesh.XZ(mesh.indices[t * 3]), mesh.XZ(mesh.indices[t * 3 + 1]),
+                                               mesh.XZ(mesh.indices[t * 3 + 2]));
+            }
+        }
+
+        //The outer boundary runs against the winding, and obstacles are wider than maxWidth.
+        if (!touchesFree || !spansTiles || winding == 0 || area * winding < 0 ||
+            2 * fabs(area) > maxWidth * perimeter)
+            return;
+
+        ring.assign(path.begin() + first, path.end());
+        const size_t size = added.size();
+        if (!ClipEars(mesh, ring, winding, added))
+            added.resize(size);
+    };
+
+    for (int first = 0; first < (int) edges.size(); first++) {
+        if (used[first])
+            continue;
+
+        path.assign(1, edges[first].y);
+        pathEdges.clear();
+        onPath[path[0]] = 0;
+
+        for (int e = first; e != -1;) {
+            used[e] = 1;
+            const int to = edges[e].x;
+            pathEdges.push_back(e);
+
+            if (onPath[to] == -1) {
+                onPath[to] = (int) path.size();
+                path.push_back(to);
+            } else {
+                //Coming back to a vertex on the path cuts off a simple loop, and the path goes on from there.
+                const int k = onPath[to];
+                closeLoop(k);
+
+                for (int i = k + 1; i < (int) path.size(); i++)
+                    onPath[path[i]] = -1;
+                path.resize(k + 1);
+                pathEdges.resize(k);
+            }
+
+            e = nextStep(to);
+        }
+
+        //What is left is an open chain along edges shared by more than two triangles.
+        for (const int v: path)
+            onPath[v] = -1;
+    }
+
+    mesh.indices.insert(mesh.indices.end(), added.begin(), added.end());
+
+    PROFILE_COUNT("Boundary loops traced", loopCount);
+    PROFILE_COUNT("Boundary loop triangles added", mesh.TriangleCount() - trianglesBefore);
+
+#pragma endregion
+}
@@ -0,0 +1,127 @@
+#ifndef CPPOPTIMIZER_HOLEFILLER_H
+#define CPPOPTIMIZER_HOLEFILLER_H
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "MathC.h"
+#include "NavMeshData.h"
+#include "ThreadPool.h"
+#include "UniformGrid.h"
+
+using namespace std;
+
+/// <summary>
+///     How holes are found and closed.
+///     Candidates tests every triangle spanned by connected vertices against the existing triangles and pushes
+///     vertices out of the triangles they overlap.
+///     BoundaryLoops traces the loops of boundary edges and triangulates the narrow ones by ear clipping, in time
+///     linear in the edge count for the small loops it closes. Vertices are not pushed.
+/// </summary>
+enum class HoleFillMode {
+    Candidates,
+    BoundaryLoops
+};
+
+/// <summary>
+///     Pushes vertices out of triangles they overlap and closes holes by adding every triangle spanned by already
+///     connected vertices that does not overlap an existing triangle in the XZ plane.
+///     Existing triangles are kept in a uniform grid over their bounding boxes so overlap tests only visit nearby
+///     triangles, and a hash set of vertex triples answers whether a candidate already exists.
+///     Pushes and candidates are decided with the tolerance tests of MathC, the tests the finalTriangleCount of the
+///     reference meshes was made with, so the output matches those counts.
+///     With a thread pool both the vertex push test and the candidate test run against a frozen snapshot of the
+///     mesh in parallel, after which the results are merged in the serial order, so the output does not depend on
+///     the thread count.
+/// </summary>
+class HoleFiller {
+private:
+    /// <summary>
+    ///     Padding added to the grid bounds of each triangle, so rounding in the cell lookup of a point on the bounds
+    ///     can not miss the triangle.
+    /// </summary>
+    static constexpr float boundsPadding = 0.01f;
+
+    /// <summary>
+    ///     Buffers owned by a single thread and reused for every query it runs.
+    /// </summary>
+    struct Scratch {
+        TriangleBatch2D overlapping;
+        vector<uint8_t> hits;
+        vector<int> cellTriangles;
+
+        /// <summary>
+        ///     Stamp per triangle so a triangle spanning several cells is only tested once per query.
+        /// </summary>
+        vector<int> visited;
+        int query = 0;
+    };
+
+    static void InsertTriangle(UniformGrid &grid, const NavMeshData &mesh, int t);
+
+    /// <summary>
+    ///     Unlinks the triangle from the cells of its current bounds, before one of its vertices moves.
+    /// </summary>
+    static void RemoveTriangle(UniformGrid &grid, const NavMeshData &mesh, int t);
+
+    /// <summary>
+    ///     Links the triangle into the cells of its current bounds in triangle order, after one of its vertices moved.
+    /// </summary>
+    static void ReinsertTriangle(UniformGrid &grid, const NavMeshData &mesh, int t);
+
+    static void ResetGrid(UniformGrid &grid, const NavMeshData &mesh, float cellSize);
+
+    static void BuildGrid(UniformGrid &grid, const NavMeshData &mesh, float cellSize);
+
+    static void BuildConnections(const NavMeshData &mesh, pmr::vector<pmr::vector<int>> &connectionsByIndex);
+
+    /// <summary>
+    ///     Tests the vertex against the triangles in its grid cell. When apply is set the vertex is pushed out of
+    ///     every triangle it lies within, in triangle order.
+    /// </summary>
+    /// <returns>True when the vertex lies within any triangle.</returns>
+    static bool PushVertex(NavMeshData &mesh, const UniformGrid &grid, int i, bool apply, Scratch &scratch);
+
+    /// <returns>True when the candidate overlaps any triangle stored in the grid.</returns>
+    static bool Overlaps(const NavMeshData &mesh, const UniformGrid &grid, const array<int, 3> &candidate,
+                         Scratch &scratch);
+
+    /// <summary>
+    ///     Triangulates a simple loop by ear clipping. Ears must turn with the winding, or be a vertex lying between
+    ///     its collinear neighbors, and may not contain or touch another vertex of the loop.
+    /// </summary>
+    /// <returns>False when no ear is left before the loop is closed, in which case the output is incomplete.</returns>
+    static bool ClipEars(const NavMeshData &mesh, pmr::vector<int> &ring, double winding, pmr::vector<int> &out);
+
+public:
+    /// <param name="pool">Optional pool to run the vertex and candidate tests on, null runs everything inline.</param>
+    /// <param name="firstFreeVertex">
+    ///     Vertices below this id belong to a part of the mesh that was filled before. They are not pushed, and
+    ///     candidates made only of them are not considered.
+    /// </param>
+    /// <param name="memory">Resource for the temporary lists, only used from the calling thread.</param>
+    static void FillHoles(NavMeshData &mesh, float cellSize, ThreadPool *pool = nullptr, int firstFreeVertex = 0,
+                          pmr::memory_resource *memory = pmr::get_default_resource());
+
+    /// <summary>
+    ///     Closes holes by splitting the boundary edges into simple loops, cut apart at vertices the boundary passes
+    ///     more than once, and triangulating every loop that bounds a gap narrower than maxWidth. The width of a loop
+    ///     is twice its area over its perimeter, so the zero area cracks left around T-junctions are always closed
+    ///     while the outer boundary, which winds against the triangles, and obstacles are left open. The added
+    ///     triangles follow the winding of the triangles along the loop, so every closed loop edge ends up shared
+    ///     by exactly two triangles. A loop that can not be clipped completely is left open.
+    /// </summary>
+    /// <param name="firstFreeVertex">Loops made only of vertices below this id are left open.</param>
+    /// <param name="memory">Resource for the temporary lists.</param>
+    /// <param name="triangleTile">
+    ///     Optional tile per triangle. Loops that only touch triangles of one tile were filled with that tile and
+    ///     are left open, so only the holes spanning a tile border are closed.
+    /// </param>
+    static void FillHoleLoops(NavMeshData &mesh, float maxWidth, int firstFreeVertex = 0,
+                              pmr::memory_resource *memory = pmr::get_default_resource(),
+                              const vector<int> *triangleTile = nullptr);
+};
+
+
+#endif //CPPOPTIMIZER_HOLEFILLER_H
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "NavMeshJsonReader.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+#pragma region Allocation tracking
+
+//Every allocation carries its size in a header so the live and peak heap usage can be followed.
+static size_t liveBytes = 0, peakBytes = 0;
+
+struct alignas(max_align_t) AllocationHeader {
+    size_t size;
+};
+
+void *operator new(size_t size) {
+    auto *header = (AllocationHeader *) malloc(sizeof(AllocationHeader) + size);
+    if (header == nullptr)
+        throw bad_alloc();
+
+    header->size = size;
+    liveBytes += size;
+    if (liveBytes > peakBytes)
+        peakBytes = liveBytes;
+
+    return header + 1;
+}
+
+void operator delete(void *memory) noexcept {
+    if (memory == nullptr)
+        return;
+
+    //Recovered through an integer, as the compiler would otherwise see a read before the object being deleted when
+    //it inlines this into a destructor.
+    auto *header = (AllocationHeader *) ((uintptr_t) memory - sizeof(AllocationHeader));
+    liveBytes -= header->size;
+    free(header);
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void *memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+#pragma endregion
+
+struct LoaderResult {
+    double milliseconds;
+    size_t peakBytes;
+};
+
+static LoaderResult Measure(NavMeshImport (*load)(const fs::path &), const fs::path &file, const int repeatCount) {
+    size_t peak = 0;
+    auto timerStart = high_resolution_clock::now();
+
+    for (int i = 0; i < repeatCount; i++) {
+        size_t before = liveBytes;
+        peakBytes = liveBytes;
+        {
+            NavMeshImport navMeshImport = load(file);
+        }
+        if (peakBytes - before > peak)
+            peak = peakBytes - before;
+    }
+
+    return {duration<double, milli>(high_resolution_clock::now() - timerStart).count() / repeatCount, peak};
+}
+
+static bool SameImport(NavMeshImport &a, NavMeshImport &b) {
+    if (a.getVertices().size() != b.getVertices().size() || a.getIndices() != b.getIndices() ||
+        a.getCleanPoint() != b.getCleanPoint() || a.FV() != b.FV() || a.FI() != b.FI() || a.FT() != b.FT())
+        return false;
+
+    for (int i = 0; i < (int) a.getVertices().size(); i++) {
+        Vector3 &va = a.getVertices()[i], &vb = b.getVertices()[i];
+        if (va.x != vb.x || va.y != vb.y || va.z != vb.z)
+            return false;
+    }
+    return true;
+}
+
+/// <summary>
+///     Loads every json file in the given directories or file list with the json document loader and the
+///     streaming loader, reports the average load time and the peak heap growth of both and checks that they
+///     produce identical imports. Returns a non zero exit code on any difference.
+/// </summary>
+int main(int argc, char *argv[]) {
+    const int repeatCount = 20;
+
+    vector<fs::path> files = vector<fs::path>();
+    for (int i = 1; i < argc; i++) {
+        if (!fs::is_directory(argv[i])) {
+            files.emplace_back(argv[i]);
+            continue;
+        }
+
+        for (const fs::directory_entry &entry: fs::directory_iterator(argv[i])) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json")
+                files.push_back(entry.path());
+        }
+    }
+    sort(files.begin(), files.end());
+
+    if (files.empty()) {
+        cout << "Usage: LoaderBenchmark <directory or json file>...\n";
+        return 1;
+    }
+
+    int mismatches = 0;
+    double domTotal = 0, streamTotal = 0;
+
+    cout << "File, Size (KB), DOM (ms), Stream (ms), DOM peak (KB), Stream peak (KB)\n";
+    for (const fs::path &file: files) {
+        NavMeshImport dom = NavMeshJsonReader::LoadDom(file), stream = NavMeshJsonReader::Load(file);
+        if (!SameImport(dom, stream)) {
+            cout << file << ": loaders disagree\n";
+            mismatches++;
+        }
+
+        LoaderResult domResult = Measure(NavMeshJsonReader::LoadDom, file, repeatCount),
+                streamResult = Measure(NavMeshJsonReader::Load, file, repeatCount);
+
+        domTotal += domResult.milliseconds;
+        streamTotal += streamResult.milliseconds;
+
+        cout << file.filename().string() << ", " << fs::file_size(file) / 1024 << ", "
+             << domResult.milliseconds << ", " << streamResult.milliseconds << ", "
+             << domResult.peakBytes / 1024 << ", " << streamResult.peakBytes / 1024 << "\n";
+    }
+
+    cout << "Total load time, DOM: " << domTotal << "(ms) | Stream: " << streamTotal << "(ms) | Speedup: "
+         << domTotal / streamTotal << "x\n";
+    cout << "Mismatches: " << mismatches << "\n";
+
+    return mismatches == 0 ? 0 : 1;
+}
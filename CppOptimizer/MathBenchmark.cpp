@@ -0,0 +1,127 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "MathC.h"
+
+using namespace std;
+using namespace chrono;
+
+/// <summary>
+///     Times the MathC batch kernels against their scalar versions on random triangles and checks that both
+///     give the same answer for every pair. Returns a non zero exit code on any mismatch.
+/// </summary>
+int main() {
+    const int triangleCount = 4096, queryCount = 256, repeatCount = 20;
+
+    mt19937 random = mt19937(1234);
+    uniform_real_distribution<float> position = uniform_real_distribution<float>(-20.0f, 20.0f),
+            size = uniform_real_distribution<float>(-6.0f, 6.0f);
+
+    TriangleBatch2D batch = TriangleBatch2D();
+    for (int i = 0; i < triangleCount; i++) {
+        Vector2 a = Vector2(position(random), position(random));
+        batch.Add(a, Vector2(a.x + size(random), a.y + size(random)), Vector2(a.x + size(random), a.y + size(random)));
+    }
+
+    vector<Vector2> points = vector<Vector2>(), queryA = vector<Vector2>(), queryB = vector<Vector2>(),
+            queryC = vector<Vector2>();
+    for (int i = 0; i < queryCount; i++) {
+        points.emplace_back(position(random), position(random));
+
+        Vector2 a = Vector2(position(random), position(random));
+        queryA.push_back(a);
+        queryB.emplace_back(a.x + size(random), a.y + size(random));
+        queryC.emplace_back(a.x + size(random), a.y + size(random));
+    }
+
+    //Every fourth query touches a batch triangle, on a corner or the middle of an edge, as the hole filler's queries
+    //do. These are the cases the orientation filter can not decide.
+    for (int i = 0; i < queryCount; i += 4) {
+        const int t = i % triangleCount;
+        const Vector2 a = Vector2(batch.ax[t], batch.ay[t]), b = Vector2(batch.bx[t], batch.by[t]);
+
+        points[i] = i % 8 == 0 ? a : Vector2::Lerp(a, b, 0.5f);
+        queryA[i] = a;
+        queryB[i] = b;
+    }
+
+    vector<uint8_t> scalar = vector<uint8_t>((size_t) triangleCount * queryCount),
+            batched = vector<uint8_t>((size_t) triangleCount * queryCount),
+            result = vector<uint8_t>(triangleCount);
+
+    cout << "Batch instruction set: " << MathC::BatchInstructionSet() << "\n";
+    cout << "Triangles: " << triangleCount << " | Queries: " << queryCount << " | Repeats: " << repeatCount << "\n\n";
+
+    int failures = 0;
+
+    const char *names[4] = {"PointWithinTriangle2D", "TriangleIntersect2D", "PointWithinTriangle2DWithTolerance",
+                            "TriangleIntersect2DWithTolerance"};
+
+    for (int kernel = 0; kernel < 4; kernel++) {
+        const char *name = names[kernel];
+
+        auto start = steady_clock::now();
+        for (int r = 0; r < repeatCount; r++) {
+            for (int q = 0; q < queryCount; q++) {
+                for (int t = 0; t < triangleCount; t++) {
+                    Vector2 a = Vector2(batch.ax[t], batch.ay[t]),
+                            b = Vector2(batch.bx[t], batch.by[t]),
+                            c = Vector2(batch.cx[t], batch.cy[t]);
+
+                    bool hit;
+                    if (kernel == 0)
+                        hit = MathC::PointWithinTriangle2D(points[q], a, b, c);
+                    else if (kernel == 1)
+                        hit = MathC::TriangleIntersect2D(queryA[q], queryB[q], queryC[q], a, b, c);
+                    else if (kernel == 2)
+                        hit = MathC::PointWithinTriangle2DWithTolerance(points[q], a, b, c);
+                    else
+                        hit = MathC::TriangleIntersect2DWithTolerance(queryA[q], queryB[q], queryC[q], a, b, c);
+
+                    scalar[(size_t) q * triangleCount + t] = hit;
+                }
+            }
+        }
+        double scalarTime = (double) duration_cast<nanoseconds>(steady_clock::now() - start).count();
+
+        start = steady_clock::now();
+        for (int r = 0; r < repeatCount; r++) {
+            for (int q = 0; q < queryCount; q++) {
+                fill(result.begin(), result.end(), 0);
+
+                if (kernel == 0)
+                    MathC::PointWithinTriangles2D(points[q], batch, result);
+                else if (kernel == 1)
+                    MathC::TriangleIntersects2D(queryA[q], queryB[q], queryC[q], batch, result);
+                else if (kernel == 2)
+                    MathC::PointWithinTriangles2DWithTolerance(points[q], batch, result);
+                else
+                    MathC::TriangleIntersects2DWithTolerance(queryA[q], queryB[q], queryC[q], batch, result);
+
+                copy(result.begin(), result.end(), batched.begin() + (long) q * triangleCount);
+            }
+        }
+        double batchTime = (double) duration_cast<nanoseconds>(steady_clock::now() - start).count();
+
+        int mismatches = 0, hits = 0;
+        for (size_t i = 0; i < scalar.size(); i++) {
+            if (scalar[i] != batched[i])
+                mismatches++;
+            hits += scalar[i];
+        }
+
+        const double tests = (double) triangleCount * queryCount * repeatCount;
+        cout << name << "\n";
+        cout << "   Scalar: " << scalarTime / tests << "(ns/test)\n";
+        cout << "   Batch: " << batchTime / tests << "(ns/test)\n";
+        cout << "   Speedup: " << scalarTime / batchTime << "\n";
+        cout << "   Hits: " << hits << " | Mismatches: " << mismatches << "\n\n";
+
+        if (mismatches != 0)
+            failures++;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
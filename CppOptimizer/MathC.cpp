@@ -1,8 +1,312 @@
 #include "MathC.h"
+#include "Predicates.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
-bool MathC::LineIntersect2DWithTolerance(Vector2 &start1, Vector2 &end1, Vector2 &start2, Vector2 &end2) {
+/// Corners of the three triangle edges, in the order TriangleIntersect2D pairs them.
+static const int edgeStart[3] = {0, 0, 1}, edgeEnd[3] = {1, 2, 2};
+
+#pragma region Batch lanes
+
+//Thin wrappers over the widest supported double lanes so the batch kernels are written once. The orientation filter
+//runs in double, so every lane takes a float converted on load.
+#if defined(__AVX2__)
+
+#define MATHC_LANES 4
+
+typedef __m256d Lanes;
+
+static inline Lanes LanesLoad(const float *p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+static inline Lanes LanesSet(double v) { return _mm256_set1_pd(v); }
+
+static inline Lanes LanesZero() { return _mm256_setzero_pd(); }
+
+static inline Lanes LanesAdd(Lanes a, Lanes b) { return _mm256_add_pd(a, b); }
+
+static inline Lanes LanesSub(Lanes a, Lanes b) { return _mm256_sub_pd(a, b); }
+
+static inline Lanes LanesMul(Lanes a, Lanes b) { return _mm256_mul_pd(a, b); }
+
+static inline Lanes LanesAbs(Lanes a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+static inline Lanes LanesGt(Lanes a, Lanes b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+
+static inline Lanes LanesLt(Lanes a, Lanes b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+
+static inline Lanes LanesAnd(Lanes a, Lanes b) { return _mm256_and_pd(a, b); }
+
+static inline Lanes LanesOr(Lanes a, Lanes b) { return _mm256_or_pd(a, b); }
+
+static inline int LanesMask(Lanes a) { return _mm256_movemask_pd(a); }
+
+#elif defined(__SSE2__)
+
+#define MATHC_LANES 2
+
+typedef __m128d Lanes;
+
+static inline Lanes LanesLoad(const float *p) {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *) p)));
+}
+
+static inline Lanes LanesSet(double v) { return _mm_set1_pd(v); }
+
+static inline Lanes LanesZero() { return _mm_setzero_pd(); }
+
+static inline Lanes LanesAdd(Lanes a, Lanes b) { return _mm_add_pd(a, b); }
+
+static inline Lanes LanesSub(Lanes a, Lanes b) { return _mm_sub_pd(a, b); }
+
+static inline Lanes LanesMul(Lanes a, Lanes b) { return _mm_mul_pd(a, b); }
+
+static inline Lanes LanesAbs(Lanes a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+
+static inline Lanes LanesGt(Lanes a, Lanes b) { return _mm_cmpgt_pd(a, b); }
+
+static inline Lanes LanesLt(Lanes a, Lanes b) { return _mm_cmplt_pd(a, b); }
+
+static inline Lanes LanesAnd(Lanes a, Lanes b) { return _mm_and_pd(a, b); }
+
+static inline Lanes LanesOr(Lanes a, Lanes b) { return _mm_or_pd(a, b); }
+
+static inline int LanesMask(Lanes a) { return _mm_movemask_pd(a); }
+
+#endif
+
+#ifdef MATHC_LANES
+
+/// Lane version of the Predicates::Orient2D filter. Lanes whose sign the filter can not decide are or-ed into
+/// uncertain, the determinant of every other lane has the exact sign.
+static inline Lanes OrientLanes(Lanes ax, Lanes ay, Lanes bx, Lanes by, Lanes cx, Lanes cy, Lanes &uncertain) {
+    Lanes left = LanesMul(LanesSub(ax, cx), LanesSub(by, cy));
+    Lanes right = LanesMul(LanesSub(ay, cy), LanesSub(bx, cx));
+    Lanes det = LanesSub(left, right);
+
+    Lanes bound = LanesMul(LanesSet(Predicates::orientBound), LanesAdd(LanesAbs(left), LanesAbs(right)));
+    uncertain = LanesOr(uncertain, LanesLt(LanesAbs(det), bound));
+    return det;
+}
+
+/// Lanes where the determinants have strictly opposite signs. Both are at least 2^-298 in magnitude when nonzero,
+/// as the coordinates are floats, so the product can not underflow.
+static inline Lanes OppositeLanes(Lanes x, Lanes y) {
+    return LanesLt(LanesMul(x, y), LanesZero());
+}
+
+/// Lane version of PointWithinTriangle2D without a margin.
+static inline Lanes PointWithinTriangleLanes(Lanes px, Lanes py, Lanes ax, Lanes ay, Lanes bx, Lanes by,
+                                             Lanes cx, Lanes cy, Lanes &uncertain) {
+    Lanes o1 = OrientLanes(ax, ay, bx, by, px, py, uncertain);
+    Lanes o2 = OrientLanes(bx, by, cx, cy, px, py, uncertain);
+    Lanes o3 = OrientLanes(cx, cy, ax, ay, px, py, uncertain);
+
+    const Lanes zero = LanesZero();
+    Lanes positive = LanesAnd(LanesAnd(LanesGt(o1, zero), LanesGt(o2, zero)), LanesGt(o3, zero));
+    Lanes negative = LanesAnd(LanesAnd(LanesLt(o1, zero), LanesLt(o2, zero)), LanesLt(o3, zero));
+    return LanesOr(positive, negative);
+}
+
+#endif
+
+//The tolerance tests are evaluated in float as the reference was, so they run on float lanes of the same width.
+#if defined(__AVX2__)
+
+#define MATHC_FLOAT_LANES 8
+
+typedef __m256 FloatLanes;
+
+static inline FloatLanes FloatLanesLoad(const float *p) { return _mm256_loadu_ps(p); }
+
+static inline FloatLanes FloatLanesSet(float v) { return _mm256_set1_ps(v); }
+
+static inline FloatLanes LanesAdd(FloatLanes a, FloatLanes b) { return _mm256_add_ps(a, b); }
+
+static inline FloatLanes LanesSub(FloatLanes a, FloatLanes b) { return _mm256_sub_ps(a, b); }
+
+static inline FloatLanes LanesMul(FloatLanes a, FloatLanes b) { return _mm256_mul_ps(a, b); }
+
+static inline FloatLanes LanesDiv(FloatLanes a, FloatLanes b) { return _mm256_div_ps(a, b); }
+
+static inline FloatLanes LanesMin(FloatLanes a, FloatLanes b) { return _mm256_min_ps(a, b); }
+
+static inline FloatLanes LanesMax(FloatLanes a, FloatLanes b) { return _mm256_max_ps(a, b); }
+
+static inline FloatLanes LanesGt(FloatLanes a, FloatLanes b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+
+static inline FloatLanes LanesLt(FloatLanes a, FloatLanes b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+
+static inline FloatLanes LanesGe(FloatLanes a, FloatLanes b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+
+static inline FloatLanes LanesLe(FloatLanes a, FloatLanes b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+
+static inline FloatLanes LanesEq(FloatLanes a, FloatLanes b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+
+static inline FloatLanes LanesAnd(FloatLanes a, FloatLanes b) { return _mm256_and_ps(a, b); }
+
+static inline FloatLanes LanesOr(FloatLanes a, FloatLanes b) { return _mm256_or_ps(a, b); }
+
+static inline FloatLanes LanesAndNot(FloatLanes notA, FloatLanes b) { return _mm256_andnot_ps(notA, b); }
+
+static inline int LanesMask(FloatLanes a) { return _mm256_movemask_ps(a); }
+
+#elif defined(__SSE2__)
+
+#define MATHC_FLOAT_LANES 4
+
+typedef __m128 FloatLanes;
+
+static inline FloatLanes FloatLanesLoad(const float *p) { return _mm_loadu_ps(p); }
+
+static inline FloatLanes FloatLanesSet(float v) { return _mm_set1_ps(v); }
+
+static inline FloatLanes LanesAdd(FloatLanes a, FloatLanes b) { return _mm_add_ps(a, b); }
+
+static inline FloatLanes LanesSub(FloatLanes a, FloatLanes b) { return _mm_sub_ps(a, b); }
+
+static inline FloatLanes LanesMul(FloatLanes a, FloatLanes b) { return _mm_mul_ps(a, b); }
+
+static inline FloatLanes LanesDiv(FloatLanes a, FloatLanes b) { return _mm_div_ps(a, b); }
+
+static inline FloatLanes LanesMin(FloatLanes a, FloatLanes b) { return _mm_min_ps(a, b); }
+
+static inline FloatLanes LanesMax(FloatLanes a, FloatLanes b) { return _mm_max_ps(a, b); }
+
+static inline FloatLanes LanesGt(FloatLanes a, FloatLanes b) { return _mm_cmpgt_ps(a, b); }
+
+static inline FloatLanes LanesLt(FloatLanes a, FloatLanes b) { return _mm_cmplt_ps(a, b); }
+
+static inline FloatLanes LanesGe(FloatLanes a, FloatLanes b) { return _mm_cmpge_ps(a, b); }
+
+static inline FloatLanes LanesLe(FloatLanes a, FloatLanes b) { return _mm_cmple_ps(a, b); }
+
+static inline FloatLanes LanesEq(FloatLanes a, FloatLanes b) { return _mm_cmpeq_ps(a, b); }
+
+static inline FloatLanes LanesAnd(FloatLanes a, FloatLanes b) { return _mm_and_ps(a, b); }
+
+static inline FloatLanes LanesOr(FloatLanes a, FloatLanes b) { return _mm_or_ps(a, b); }
+
+static inline FloatLanes LanesAndNot(FloatLanes notA, FloatLanes b) { return _mm_andnot_ps(notA, b); }
+
+static inline int LanesMask(FloatLanes a) { return _mm_movemask_ps(a); }
+
+#endif
+
+#ifdef MATHC_FLOAT_LANES
+
+//MathC::Min(x, x1) returns x1 only when x1 < x, which is exactly what min_ps(x1, x) does, NaN handling included.
+static inline FloatLanes LanesMathCMin(FloatLanes x, FloatLanes x1) { return LanesMin(x1, x); }
+
+static inline FloatLanes LanesMathCMax(FloatLanes y, FloatLanes y1) { return LanesMax(y1, y); }
+
+/// Lane version of PointWithinTriangle2DWithTolerance, every operation is kept in the same order as the scalar one.
+static inline FloatLanes PointWithinTriangleToleranceLanes(FloatLanes px, FloatLanes py, FloatLanes ax, FloatLanes ay,
+                                                           FloatLanes bx, FloatLanes by, FloatLanes cx, FloatLanes cy,
+                                                           const float tolerance, const float offset) {
+    const FloatLanes offsetLanes = FloatLanesSet(offset);
+
+    FloatLanes s1 = LanesAdd(LanesSub(cy, ay), offsetLanes);
+    FloatLanes s2 = LanesSub(cx, ax);
+    FloatLanes s3 = LanesSub(by, ay);
+    FloatLanes s4 = LanesSub(py, ay);
+
+    FloatLanes w1 = LanesDiv(LanesSub(LanesAdd(LanesMul(ax, s1), LanesMul(s4, s2)), LanesMul(px, s1)),
+                             LanesSub(LanesMul(s3, s2), LanesMul(LanesAdd(LanesSub(bx, ax), offsetLanes), s1)));
+    FloatLanes w2 = LanesDiv(LanesSub(s4, LanesMul(w1, s3)), s1);
+
+    return LanesAnd(LanesAnd(LanesGe(w1, FloatLanesSet(tolerance)), LanesGe(w2, FloatLanesSet(tolerance))),
+                    LanesLe(LanesAdd(w1, w2), FloatLanesSet(1.0f - tolerance)));
+}
+
+/// Lane version of LineIntersect2DWithTolerance, every operation is kept in the same order as the scalar one.
+static inline FloatLanes LineIntersectToleranceLanes(FloatLanes start1x, FloatLanes start1y, FloatLanes end1x,
+                                                     FloatLanes end1y, FloatLanes start2x, FloatLanes start2y,
+                                                     FloatLanes end2x, FloatLanes end2y, const float lineTolerance) {
+    FloatLanes a1 = LanesSub(end1y, start1y);
+    FloatLanes b1 = LanesSub(start1x, end1x);
+    FloatLanes c1 = LanesAdd(LanesMul(a1, start1x), LanesMul(b1, start1y));
+
+    FloatLanes a2 = LanesSub(end2y, start2y);
+    FloatLanes b2 = LanesSub(start2x, end2x);
+    FloatLanes c2 = LanesAdd(LanesMul(a2, start2x), LanesMul(b2, start2y));
+
+    FloatLanes denominator = LanesSub(LanesMul(a1, b2), LanesMul(a2, b1));
+
+    FloatLanes pointX = LanesDiv(LanesSub(LanesMul(b2, c1), LanesMul(b1, c2)), denominator);
+    FloatLanes pointY = LanesDiv(LanesSub(LanesMul(a1, c2), LanesMul(a2, c1)), denominator);
+
+    FloatLanes rejected = LanesEq(denominator, FloatLanesSet(0.0f));
+    rejected = LanesOr(rejected, LanesAnd(LanesEq(pointX, start1x), LanesEq(pointY, start1y)));
+    rejected = LanesOr(rejected, LanesAnd(LanesEq(pointX, end1x), LanesEq(pointY, end1y)));
+    rejected = LanesOr(rejected, LanesAnd(LanesEq(pointX, start2x), LanesEq(pointY, start2y)));
+    rejected = LanesOr(rejected, LanesAnd(LanesEq(pointX, end2x), LanesEq(pointY, end2y)));
+
+    const FloatLanes tolerance = FloatLanesSet(lineTolerance);
+
+    FloatLanes within = LanesGt(pointX, LanesAdd(LanesMathCMin(start1x, end1x), tolerance));
+    within = LanesAnd(within, LanesLt(pointX, LanesSub(LanesMathCMax(start1x, end1x), tolerance)));
+    within = LanesAnd(within, LanesGt(pointX, LanesAdd(LanesMathCMin(start2x, end2x), tolerance)));
+    within = LanesAnd(within, LanesLt(pointX, LanesSub(LanesMathCMax(start2x, end2x), tolerance)));
+    within = LanesAnd(within, LanesGt(pointY, LanesAdd(LanesMathCMin(start1y, end1y), tolerance)));
+    within = LanesAnd(within, LanesLt(pointY, LanesSub(LanesMathCMax(start1y, end1y), tolerance)));
+    within = LanesAnd(within, LanesGt(pointY, LanesAdd(LanesMathCMin(start2y, end2y), tolerance)));
+    within = LanesAnd(within, LanesLt(pointY, LanesSub(LanesMathCMax(start2y, end2y), tolerance)));
+
+    return LanesAndNot(rejected, within);
+}
+
+#endif
+
+#pragma endregion
+
+#pragma region Scalar predicates
+
+/// Determinants with strictly opposite signs, see OppositeLanes.
+static inline bool Opposite(const double x, const double y) {
+    return x * y < 0;
+}
+
+bool MathC::LineIntersect2D(const Vector2 &start1, const Vector2 &end1, const Vector2 &start2, const Vector2 &end2) {
+    return Opposite(Predicates::Orient2D(start1, end1, start2), Predicates::Orient2D(start1, end1, end2)) &&
+           Opposite(Predicates::Orient2D(start2, end2, start1), Predicates::Orient2D(start2, end2, end1));
+}
+
+bool MathC::TriangleIntersect2D(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3, const Vector2 &b1,
+                                const Vector2 &b2, const Vector2 &b3) {
+    const Vector2 *a[3] = {&a1, &a2, &a3}, *b[3] = {&b1, &b2, &b3};
+
+    //Side of every corner of one triangle to every edge of the other, each shared by two of the nine edge pairs.
+    double aEdges[3][3], bEdges[3][3];
+    for (int e = 0; e < 3; e++) {
+        for (int v = 0; v < 3; v++) {
+            aEdges[e][v] = Predicates::Orient2D(*a[edgeStart[e]], *a[edgeEnd[e]], *b[v]);
+            bEdges[e][v] = Predicates::Orient2D(*b[edgeStart[e]], *b[edgeEnd[e]], *a[v]);
+        }
+    }
+
+    for (int j = 0; j < 3; j++) {
+        for (int i = 0; i < 3; i++) {
+            if (Opposite(aEdges[i][edgeStart[j]], aEdges[i][edgeEnd[j]]) &&
+                Opposite(bEdges[j][edgeStart[i]], bEdges[j][edgeEnd[i]]))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+#pragma endregion
+
+#pragma region Reference tolerance tests
+
+bool MathC::LineIntersect2DWithTolerance(const Vector2 &start1, const Vector2 &end1, const Vector2 &start2,
+                                         const Vector2 &end2) {
     //Line1
     float a1 = end1.y - start1.y;
     float b1 = start1.x - end1.x;
@@ -24,31 +328,30 @@ bool MathC::LineIntersect2DWithTolerance(Vector2 &start1, Vector2 &end1, Vector2
         point == start2 || point == end2)
         return false;
 
-    const float tolerance = 0.001f;
-
-    return point.x > MathC::Min(start1.x, end1.x) + tolerance &&
-           point.x < MathC::Max(start1.x, end1.x) - tolerance &&
-           point.x > MathC::Min(start2.x, end2.x) + tolerance &&
-           point.x < MathC::Max(start2.x, end2.x) - tolerance &&
-           point.y > MathC::Min(start1.y, end1.y) + tolerance &&
-           point.y < MathC::Max(start1.y, end1.y) - tolerance &&
-           point.y > MathC::Min(start2.y, end2.y) + tolerance &&
-           point.y < MathC::Max(start2.y, end2.y) - tolerance;
+    return point.x > Min(start1.x, end1.x) + lineTolerance &&
+           point.x < Max(start1.x, end1.x) - lineTolerance &&
+           point.x > Min(start2.x, end2.x) + lineTolerance &&
+           point.x < Max(start2.x, end2.x) - lineTolerance &&
+           point.y > Min(start1.y, end1.y) + lineTolerance &&
+           point.y < Max(start1.y, end1.y) - lineTolerance &&
+           point.y > Min(start2.y, end2.y) + lineTolerance &&
+           point.y < Max(start2.y, end2.y) - lineTolerance;
 }
 
-bool MathC::PointWithinTriangle2DWithTolerance(Vector2 &point, Vector2 &a, Vector2 &b, Vector2 &c) {
-    float tolerance = 0.001f;
-    float s1 = c.y - a.y + 0.0001f;
+bool MathC::PointWithinTriangle2DWithTolerance(const Vector2 &point, const Vector2 &a, const Vector2 &b,
+                                               const Vector2 &c) {
+    float s1 = c.y - a.y + denominatorOffset;
     float s2 = c.x - a.x;
     float s3 = b.y - a.y;
     float s4 = point.y - a.y;
 
-    float w1 = (a.x * s1 + s4 * s2 - point.x * s1) / (s3 * s2 - (b.x - a.x + 0.0001f) * s1);
+    float w1 = (a.x * s1 + s4 * s2 - point.x * s1) / (s3 * s2 - (b.x - a.x + denominatorOffset) * s1);
     float w2 = (s4 - w1 * s3) / s1;
-    return w1 >= tolerance && w2 >= tolerance && w1 + w2 <= 1.0f - tolerance;
+    return w1 >= pointTolerance && w2 >= pointTolerance && w1 + w2 <= 1.0f - pointTolerance;
 }
 
-bool MathC::TriangleIntersect2D(Vector2 &a1, Vector2 &a2, Vector2 &a3, Vector2 &b1, Vector2 &b2, Vector2 &b3) {
+bool MathC::TriangleIntersect2DWithTolerance(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3,
+                                             const Vector2 &b1, const Vector2 &b2, const Vector2 &b3) {
     return LineIntersect2DWithTolerance(a1, a2, b1, b2) ||
            LineIntersect2DWithTolerance(a1, a3, b1, b2) ||
            LineIntersect2DWithTolerance(a2, a3, b1, b2) ||
@@ -60,6 +363,230 @@ bool MathC::TriangleIntersect2D(Vector2 &a1, Vector2 &a2, Vector2 &a3, Vector2 &
            LineIntersect2DWithTolerance(a2, a3, b2, b3);
 }
 
+#pragma endregion
+
+void TriangleBatch2D::Add(const Vector2 &a, const Vector2 &b, const Vector2 &c) {
+    ax.push_back(a.x);
+    ay.push_back(a.y);
+    bx.push_back(b.x);
+    by.push_back(b.y);
+    cx.push_back(c.x);
+    cy.push_back(c.y);
+}
+
+void TriangleBatch2D::Clear() {
+    ax.clear();
+    ay.clear();
+    bx.clear();
+    by.clear();
+    cx.clear();
+    cy.clear();
+}
+
+int TriangleBatch2D::Size() const {
+    return (int) ax.size();
+}
+
+template<class Policy>
+void MathC::PointWithinTriangles2D(const Vector2 &point, const TriangleBatch2D &triangles,
+                                   vector<uint8_t> &result, const typename Policy::Scalar margin) {
+    const int count = triangles.Size();
+    if ((int) result.size() < count)
+        result.resize(count, 0);
+
+    int i = 0;
+
+#ifdef MATHC_LANES
+    const Lanes px = LanesSet(point.x), py = LanesSet(point.y);
+
+    for (; i + MATHC_LANES <= count; i += MATHC_LANES) {
+        Lanes uncertain = LanesZero();
+        int mask = LanesMask(PointWithinTriangleLanes(px, py,
+                                                      LanesLoad(&triangles.ax[i]), LanesLoad(&triangles.ay[i]),
+                                                      LanesLoad(&triangles.bx[i]), LanesLoad(&triangles.by[i]),
+                                                      LanesLoad(&triangles.cx[i]), LanesLoad(&triangles.cy[i]),
+                                                      uncertain));
+        int uncertainMask = LanesMask(uncertain);
+
+        //The margin is compared in the Scalar of the policy, so hits are confirmed by the scalar test.
+        if (margin != 0)
+            uncertainMask |= mask;
+
+        for (int lane = 0; lane < MATHC_LANES; lane++) {
+            const int t = i + lane;
+            if ((uncertainMask >> lane) & 1)
+                result[t] |= (uint8_t) PointWithinTriangle2D<Policy>(point,
+                                                                     Vector2(triangles.ax[t], triangles.ay[t]),
+                                                                     Vector2(triangles.bx[t], triangles.by[t]),
+                                                                     Vector2(triangles.cx[t], triangles.cy[t]),
+                                                                     margin);
+            else
+                result[t] |= (uint8_t) ((mask >> lane) & 1);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        Vector2 a = Vector2(triangles.ax[i], triangles.ay[i]),
+                b = Vector2(triangles.bx[i], triangles.by[i]),
+                c = Vector2(triangles.cx[i], triangles.cy[i]);
+
+        result[i] |= (uint8_t) PointWithinTriangle2D<Policy>(point, a, b, c, margin);
+    }
+}
+
+template void MathC::PointWithinTriangles2D<FloatPolicy>(const Vector2 &point, const TriangleBatch2D &triangles,
+                                                         vector<uint8_t> &result, float margin);
+
+template void MathC::PointWithinTriangles2D<DoublePolicy>(const Vector2 &point, const TriangleBatch2D &triangles,
+                                                          vector<uint8_t> &result, double margin);
+
+void MathC::TriangleIntersects2D(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3,
+                                 const TriangleBatch2D &triangles, vector<uint8_t> &result) {
+    const int count = triangles.Size();
+    if ((int) result.size() < count)
+        result.resize(count, 0);
+
+    int i = 0;
+
+#ifdef MATHC_LANES
+    const Lanes ax[3] = {LanesSet(a1.x), LanesSet(a2.x), LanesSet(a3.x)},
+            ay[3] = {LanesSet(a1.y), LanesSet(a2.y), LanesSet(a3.y)};
+
+    for (; i + MATHC_LANES <= count; i += MATHC_LANES) {
+        const Lanes bx[3] = {LanesLoad(&triangles.ax[i]), LanesLoad(&triangles.bx[i]), LanesLoad(&triangles.cx[i])},
+                by[3] = {LanesLoad(&triangles.ay[i]), LanesLoad(&triangles.by[i]), LanesLoad(&triangles.cy[i])};
+
+        //Same orientations and edge pairs as TriangleIntersect2D.
+        Lanes uncertain = LanesZero();
+        Lanes aEdges[3][3], bEdges[3][3];
+        for (int e = 0; e < 3; e++) {
+            for (int v = 0; v < 3; v++) {
+                aEdges[e][v] = OrientLanes(ax[edgeStart[e]], ay[edgeStart[e]], ax[edgeEnd[e]], ay[edgeEnd[e]],
+                                           bx[v], by[v], uncertain);
+                bEdges[e][v] = OrientLanes(bx[edgeStart[e]], by[edgeStart[e]], bx[edgeEnd[e]], by[edgeEnd[e]],
+                                           ax[v], ay[v], uncertain);
+            }
+        }
+
+        Lanes hit = LanesZero();
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++)
+                hit = LanesOr(hit, LanesAnd(OppositeLanes(aEdges[k][edgeStart[j]], aEdges[k][edgeEnd[j]]),
+                                            OppositeLanes(bEdges[j][edgeStart[k]], bEdges[j][edgeEnd[k]])));
+        }
+
+        int mask = LanesMask(hit), uncertainMask = LanesMask(uncertain);
+        for (int lane = 0; lane < MATHC_LANES; lane++) {
+            const int t = i + lane;
+            if ((uncertainMask >> lane) & 1)
+                result[t] |= (uint8_t) TriangleIntersect2D(a1, a2, a3, Vector2(triangles.ax[t], triangles.ay[t]),
+                                                           Vector2(triangles.bx[t], triangles.by[t]),
+                                                           Vector2(triangles.cx[t], triangles.cy[t]));
+            else
+                result[t] |= (uint8_t) ((mask >> lane) & 1);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        Vector2 b1 = Vector2(triangles.ax[i], triangles.ay[i]),
+                b2 = Vector2(triangles.bx[i], triangles.by[i]),
+                b3 = Vector2(triangles.cx[i], triangles.cy[i]);
+
+        result[i] |= (uint8_t) TriangleIntersect2D(a1, a2, a3, b1, b2, b3);
+    }
+}
+
+void MathC::PointWithinTriangles2DWithTolerance(const Vector2 &point, const TriangleBatch2D &triangles,
+                                                vector<uint8_t> &result) {
+    const int count = triangles.Size();
+    if ((int) result.size() < count)
+        result.resize(count, 0);
+
+    int i = 0;
+
+#ifdef MATHC_FLOAT_LANES
+    const FloatLanes px = FloatLanesSet(point.x), py = FloatLanesSet(point.y);
+
+    for (; i + MATHC_FLOAT_LANES <= count; i += MATHC_FLOAT_LANES) {
+        int mask = LanesMask(PointWithinTriangleToleranceLanes(px, py,
+                                                               FloatLanesLoad(&triangles.ax[i]),
+                                                               FloatLanesLoad(&triangles.ay[i]),
+                                                               FloatLanesLoad(&triangles.bx[i]),
+                                                               FloatLanesLoad(&triangles.by[i]),
+                                                               FloatLanesLoad(&triangles.cx[i]),
+                                                               FloatLanesLoad(&triangles.cy[i]),
+                                                               pointTolerance, denominatorOffset));
+
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+            result[i + lane] |= (uint8_t) (mask & 1);
+    }
+#endif
+
+    for (; i < count; i++) {
+        Vector2 a = Vector2(triangles.ax[i], triangles.ay[i]),
+                b = Vector2(triangles.bx[i], triangles.by[i]),
+                c = Vector2(triangles.cx[i], triangles.cy[i]);
+
+        result[i] |= (uint8_t) PointWithinTriangle2DWithTolerance(point, a, b, c);
+    }
+}
+
+void MathC::TriangleIntersects2DWithTolerance(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3,
+                                              const TriangleBatch2D &triangles, vector<uint8_t> &result) {
+    const int count = triangles.Size();
+    if ((int) result.size() < count)
+        result.resize(count, 0);
+
+    int i = 0;
+
+#ifdef MATHC_FLOAT_LANES
+    const FloatLanes a1x = FloatLanesSet(a1.x), a1y = FloatLanesSet(a1.y),
+            a2x = FloatLanesSet(a2.x), a2y = FloatLanesSet(a2.y),
+            a3x = FloatLanesSet(a3.x), a3y = FloatLanesSet(a3.y);
+
+    for (; i + MATHC_FLOAT_LANES <= count; i += MATHC_FLOAT_LANES) {
+        FloatLanes b1x = FloatLanesLoad(&triangles.ax[i]), b1y = FloatLanesLoad(&triangles.ay[i]),
+                b2x = FloatLanesLoad(&triangles.bx[i]), b2y = FloatLanesLoad(&triangles.by[i]),
+                b3x = FloatLanesLoad(&triangles.cx[i]), b3y = FloatLanesLoad(&triangles.cy[i]);
+
+        //Same edge pairs as TriangleIntersect2DWithTolerance.
+        FloatLanes hit = LineIntersectToleranceLanes(a1x, a1y, a2x, a2y, b1x, b1y, b2x, b2y, lineTolerance);
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a1x, a1y, a3x, a3y, b1x, b1y, b2x, b2y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a2x, a2y, a3x, a3y, b1x, b1y, b2x, b2y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a1x, a1y, a2x, a2y, b1x, b1y, b3x, b3y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a1x, a1y, a3x, a3y, b1x, b1y, b3x, b3y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a2x, a2y, a3x, a3y, b1x, b1y, b3x, b3y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a1x, a1y, a2x, a2y, b2x, b2y, b3x, b3y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a1x, a1y, a3x, a3y, b2x, b2y, b3x, b3y, lineTolerance));
+        hit = LanesOr(hit, LineIntersectToleranceLanes(a2x, a2y, a3x, a3y, b2x, b2y, b3x, b3y, lineTolerance));
+
+        int mask = LanesMask(hit);
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+            result[i + lane] |= (uint8_t) (mask & 1);
+    }
+#endif
+
+    for (; i < count; i++) {
+        Vector2 b1 = Vector2(triangles.ax[i], triangles.ay[i]),
+                b2 = Vector2(triangles.bx[i], triangles.by[i]),
+                b3 = Vector2(triangles.cx[i], triangles.cy[i]);
+
+        result[i] |= (uint8_t) TriangleIntersect2DWithTolerance(a1, a2, a3, b1, b2, b3);
+    }
+}
+
+const char *MathC::BatchInstructionSet() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
 Vector2 MathC::ClosetPointOnLine(Vector2 &point, Vector2 &start, Vector2 &end) {
     //Get heading
     Vector2 heading = Vector2(end.x - start.x, end.y - start.y);
@@ -1,15 +1,117 @@
+#ifndef CPPOPTIMIZER_MATHC_H
+#define CPPOPTIMIZER_MATHC_H
+
+#include <cstdint>
 #include <vector>
+#include "GeometryPolicy.h"
+#include "Predicates.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
+using namespace std;
+
+/// <summary>
+///     Triangles in the XZ plane stored as one array per coordinate, the input of the MathC batch kernels.
+/// </summary>
+struct TriangleBatch2D {
+    vector<float> ax, ay, bx, by, cx, cy;
+
+    void Add(const Vector2 &a, const Vector2 &b, const Vector2 &c);
+
+    void Clear();
+
+    int Size() const;
+};
+
 class MathC {
 public:
-    static bool LineIntersect2DWithTolerance(Vector2 &start1, Vector2 &end1, Vector2 &start2, Vector2 &end2);
+    /// <summary>
+    ///     True when the segments cross at a single point inside both of them. Segments that touch, share an end or
+    ///     are collinear do not cross. Uses the exact orientation predicate.
+    /// </summary>
+    static bool LineIntersect2D(const Vector2 &start1, const Vector2 &end1, const Vector2 &start2,
+                                const Vector2 &end2);
+
+    /// <summary>
+    ///     True when the point lies inside the triangle, of either winding, farther than margin from every edge.
+    ///     With no margin the test is exact: points on an edge or a corner are outside, and degenerate triangles
+    ///     contain no point. The margin is compared in the Scalar of the policy.
+    /// </summary>
+    template<class Policy = DefaultPolicy>
+    static bool PointWithinTriangle2D(const Vector2 &point, const Vector2 &a, const Vector2 &b, const Vector2 &c,
+                                      typename Policy::Scalar margin = 0);
+
+    /// <summary>
+    ///     True when any edge of the first triangle crosses an edge of the second, as LineIntersect2D.
+    /// </summary>
+    static bool TriangleIntersect2D(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3, const Vector2 &b1,
+                                    const Vector2 &b2, const Vector2 &b3);
+
+    /// <summary>
+    ///     Batch variant of PointWithinTriangle2D testing one point against every triangle of the batch.
+    ///     Hits are or-ed into result, which is grown to the batch size when needed.
+    ///     Runs the orientation filter on AVX2 or SSE2 double lanes when the build targets them. Only the lanes the
+    ///     filter can not decide, and with a margin the hits, go through the scalar test, so the results equal the
+    ///     scalar version in both policies.
+    /// </summary>
+    template<class Policy = DefaultPolicy>
+    static void PointWithinTriangles2D(const Vector2 &point, const TriangleBatch2D &triangles,
+                                       vector<uint8_t> &result, typename Policy::Scalar margin = 0);
+
+    /// <summary>
+    ///     Batch variant of TriangleIntersect2D testing the triangle a1, a2, a3 against every triangle of the batch.
+    ///     Hits are or-ed into result, which is grown to the batch size when needed.
+    ///     Runs the orientation filter on AVX2 or SSE2 double lanes when the build targets them, and only the lanes
+    ///     the filter can not decide go through the exact scalar test, so the results equal the scalar version.
+    /// </summary>
+    static void TriangleIntersects2D(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3,
+                                     const TriangleBatch2D &triangles, vector<uint8_t> &result);
+
+    /// <summary>
+    ///     True when the crossing point of the two lines, computed in float, is none of the four ends and lies more
+    ///     than lineTolerance inside the bounds of both segments along each axis. Segments parallel to an axis
+    ///     therefore never cross. This is the test the finalTriangleCount of the reference meshes was made with,
+    ///     so the hole filler decides its candidates with it.
+    /// </summary>
+    static bool LineIntersect2DWithTolerance(const Vector2 &start1, const Vector2 &end1, const Vector2 &start2,
+                                             const Vector2 &end2);
+
+    /// <summary>
+    ///     True when both barycentric weights of the point, computed in float with denominatorOffset added to the
+    ///     denominators, are at least pointTolerance and sum to at most 1 - pointTolerance. The reference test of
+    ///     the hole filler, see LineIntersect2DWithTolerance.
+    /// </summary>
+    static bool PointWithinTriangle2DWithTolerance(const Vector2 &point, const Vector2 &a, const Vector2 &b,
+                                                   const Vector2 &c);
+
+    /// <summary>
+    ///     True when any edge of the first triangle crosses an edge of the second, as LineIntersect2DWithTolerance.
+    /// </summary>
+    static bool TriangleIntersect2DWithTolerance(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3,
+                                                 const Vector2 &b1, const Vector2 &b2, const Vector2 &b3);
 
-    static bool
-    PointWithinTriangle2DWithTolerance(Vector2 &point, Vector2 &a, Vector2 &b, Vector2 &c);
+    /// <summary>
+    ///     Batch variant of PointWithinTriangle2DWithTolerance testing one point against every triangle of the batch.
+    ///     Hits are or-ed into result, which is grown to the batch size when needed.
+    ///     Runs on AVX2 or SSE2 float lanes when the build targets them, with every operation in the order of the
+    ///     scalar version, so the results are equal.
+    /// </summary>
+    static void PointWithinTriangles2DWithTolerance(const Vector2 &point, const TriangleBatch2D &triangles,
+                                                    vector<uint8_t> &result);
 
-    static bool TriangleIntersect2D(Vector2 &a1, Vector2 &a2, Vector2 &a3, Vector2 &b1, Vector2 &b2, Vector2 &b3);
+    /// <summary>
+    ///     Batch variant of TriangleIntersect2DWithTolerance testing the triangle a1, a2, a3 against every triangle of
+    ///     the batch. Hits are or-ed into result, which is grown to the batch size when needed.
+    ///     Runs on AVX2 or SSE2 float lanes when the build targets them, with every operation in the order of the
+    ///     scalar version, so the results are equal.
+    /// </summary>
+    static void TriangleIntersects2DWithTolerance(const Vector2 &a1, const Vector2 &a2, const Vector2 &a3,
+                                                  const TriangleBatch2D &triangles, vector<uint8_t> &result);
+
+    /// <summary>
+    ///     Name of the instruction set used by the batch kernels.
+    /// </summary>
+    static const char *BatchInstructionSet();
 
     static Vector2 ClosetPointOnLine(Vector2 &point, Vector2 &start, Vector2 &end);
 
@@ -22,4 +124,50 @@ public:
     static Vector2 XZ(Vector3 &v);
 
     static Vector3 XYZ(Vector2 &v);
-};
\ No newline at end of file
+
+private:
+    ///<summary>Distance the crossing point must keep from the bounds of both segments.</summary>
+    static constexpr float lineTolerance = 0.001f;
+
+    ///<summary>Smallest barycentric weight a point within a triangle may have.</summary>
+    static constexpr float pointTolerance = 0.001f;
+
+    ///<summary>Offset added to the barycentric denominators so axis aligned edges do not divide by zero.</summary>
+    static constexpr float denominatorOffset = 0.0001f;
+
+    /// <summary>
+    ///     True when the point at the given orientation to the edge from s to e is farther than the margin from it.
+    ///     The orientation is twice the area spanned with the edge, so it is compared against the margin times the
+    ///     edge length.
+    /// </summary>
+    template<class Policy>
+    static bool BeyondMargin(double det, const Vector2 &s, const Vector2 &e, typename Policy::Scalar margin);
+};
+
+template<class Policy>
+bool MathC::PointWithinTriangle2D(const Vector2 &point, const Vector2 &a, const Vector2 &b, const Vector2 &c,
+                                  const typename Policy::Scalar margin) {
+    const double o1 = Predicates::Orient2D(a, b, point);
+    const double o2 = Predicates::Orient2D(b, c, point);
+    const double o3 = Predicates::Orient2D(c, a, point);
+    if (!((o1 > 0 && o2 > 0 && o3 > 0) || (o1 < 0 && o2 < 0 && o3 < 0)))
+        return false;
+
+    //The signs are exact, and a float area may underflow, so no margin is decided by them alone.
+    if (margin == 0)
+        return true;
+
+    return BeyondMargin<Policy>(o1, a, b, margin) && BeyondMargin<Policy>(o2, b, c, margin) &&
+           BeyondMargin<Policy>(o3, c, a, margin);
+}
+
+template<class Policy>
+bool MathC::BeyondMargin(const double det, const Vector2 &s, const Vector2 &e, const typename Policy::Scalar margin) {
+    typedef typename Policy::Scalar Scalar;
+
+    const Scalar area = (Scalar) det, dx = (Scalar) e.x - (Scalar) s.x, dy = (Scalar) e.y - (Scalar) s.y;
+    return area * area > margin * margin * (dx * dx + dy * dy);
+}
+
+
+#endif //CPPOPTIMIZER_MATHC_H
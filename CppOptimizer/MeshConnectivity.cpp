@@ -0,0 +1,78 @@
+#include "MeshConnectivity.h"
+
+using namespace std;
+
+void MeshConnectivity::Reset(const int triangleCount) {
+    visited_.assign((triangleCount + 63) / 64, 0);
+    if ((int) queue_.size() < triangleCount)
+        queue_.resize(triangleCount);
+}
+
+bool MeshConnectivity::Visited(const int t) const {
+    return (visited_[t >> 6] >> (t & 63)) & 1;
+}
+
+/// <returns>True when the triangle was not visited before.</returns>
+bool MeshConnectivity::Visit(const int t) {
+    uint64_t bit = (uint64_t) 1 << (t & 63);
+    if (visited_[t >> 6] & bit)
+        return false;
+
+    visited_[t >> 6] |= bit;
+    return true;
+}
+
+void MeshConnectivity::FloodFill(const vector<NavMeshTriangle> &triangles, const int *seeds, const int seedCount,
+                                 vector<int> &region) {
+    int head = 0, tail = 0;
+
+    for (int i = 0; i < seedCount; i++) {
+        if (Visit(seeds[i]))
+            queue_[tail++] = seeds[i];
+    }
+
+    while (head < tail) {
+        const int index = queue_[head++];
+        const NavMeshTriangle &navTriangle = triangles[index];
+        region.push_back(index);
+
+        for (int i = 0; i < navTriangle.neighborCount(); i++) {
+            int n = navTriangle.neighbor(i);
+            if (Visit(n))
+                queue_[tail++] = n;
+        }
+    }
+}
+
+int MeshConnectivity::LabelComponents(const vector<NavMeshTriangle> &triangles, vector<int> &labels,
+                                      vector<int> &componentSizes) {
+    const int triangleCount = (int) triangles.size();
+    Reset(triangleCount);
+    labels.assign(triangleCount, -1);
+    componentSizes.clear();
+
+    for (int start = 0; start < triangleCount; start++) {
+        if (!Visit(start))
+            continue;
+
+        const int component = (int) componentSizes.size();
+        int head = 0, tail = 0;
+        queue_[tail++] = start;
+
+        while (head < tail) {
+            const int index = queue_[head++];
+            const NavMeshTriangle &navTriangle = triangles[index];
+            labels[index] = component;
+
+            for (int i = 0; i < navTriangle.neighborCount(); i++) {
+                int n = navTriangle.neighbor(i);
+                if (Visit(n))
+                    queue_[tail++] = n;
+            }
+        }
+
+        componentSizes.push_back(tail);
+    }
+
+    return (int) componentSizes.size();
+}
@@ -0,0 +1,45 @@
+#ifndef CPPOPTIMIZER_MESHCONNECTIVITY_H
+#define CPPOPTIMIZER_MESHCONNECTIVITY_H
+
+#include <cstdint>
+#include <vector>
+#include "NavMeshTriangle.h"
+
+using namespace std;
+
+/// <summary>
+///     Breadth first traversal over triangle neighbors.
+///     Reached triangles are marked in a bitmap and queued in a buffer sized to the triangle count. As a triangle
+///     is queued at most once the queue never wraps, so traversals only allocate when a larger mesh comes along.
+/// </summary>
+class MeshConnectivity {
+private:
+    vector<uint64_t> visited_;
+    vector<int> queue_;
+
+    bool Visit(int t);
+
+public:
+    /// <summary>
+    ///     Sizes the buffers for the triangle count and clears every visited mark.
+    /// </summary>
+    void Reset(int triangleCount);
+
+    bool Visited(int t) const;
+
+    /// <summary>
+    ///     Appends every triangle reachable from the seeds and not visited yet to region, in breadth first order.
+    ///     Visited marks are kept until the next Reset, so several fills never return a triangle twice.
+    /// </summary>
+    void FloodFill(const vector<NavMeshTriangle> &triangles, const int *seeds, int seedCount, vector<int> &region);
+
+    /// <summary>
+    ///     Labels every triangle with the id of its connected component. Components are numbered in order of
+    ///     their lowest triangle id.
+    /// </summary>
+    /// <returns>The component count. componentSizes holds the triangle count of each component.</returns>
+    int LabelComponents(const vector<NavMeshTriangle> &triangles, vector<int> &labels, vector<int> &componentSizes);
+};
+
+
+#endif //CPPOPTIMIZER_MESHCONNECTIVITY_H
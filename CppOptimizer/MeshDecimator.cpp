@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cmath>
+#include "MeshDecimator.h"
+#include "Predicates.h"
+#include "Profiler.h"
+
+using namespace std;
+
+/// <summary>
+///     True when every vertex of the ring and the center lie within maxError of the plane of every fan triangle.
+/// </summary>
+static bool Flat(const NavMeshData &mesh, const pmr::vector<int> &fan, const pmr::vector<int> &ring, const int center,
+                 const float maxError) {
+    for (const int t: fan) {
+        const int i0 = mesh.indices[t * 3], i1 = mesh.indices[t * 3 + 1], i2 = mesh.indices[t * 3 + 2];
+        const double x1 = (double) mesh.x[i1] - mesh.x[i0], y1 = (double) mesh.y[i1] - mesh.y[i0],
+                z1 = (double) mesh.z[i1] - mesh.z[i0];
+        const double x2 = (double) mesh.x[i2] - mesh.x[i0], y2 = (double) mesh.y[i2] - mesh.y[i0],
+                z2 = (double) mesh.z[i2] - mesh.z[i0];
+
+        //Height as a function of x and z, the triangles are not degenerate in the XZ plane.
+        const double determinant = x1 * z2 - x2 * z1;
+        const double slopeX = (y1 * z2 - y2 * z1) / determinant, slopeZ = (x1 * y2 - x2 * y1) / determinant;
+
+        auto outside = [&](const int v) {
+            const double height = mesh.y[i0] + slopeX * ((double) mesh.x[v] - mesh.x[i0]) +
+                                  slopeZ * ((double) mesh.z[v] - mesh.z[i0]);
+            return fabs(height - mesh.y[v]) > maxError;
+        };
+
+        if (outside(center) || any_of(ring.begin(), ring.end(), outside))
+            return false;
+    }
+
+    return true;
+}
+
+/// <summary>
+///     True when the center lies between its two boundary neighbors and within maxError of the line through them.
+/// </summary>
+static bool Straight(const NavMeshData &mesh, const int previous, const int center, const int next,
+                     const float maxError) {
+    const double lineX = (double) mesh.x[next] - mesh.x[previous], lineZ = (double) mesh.z[next] - mesh.z[previous];
+    const double toX = (double) mesh.x[center] - mesh.x[previous], toZ = (double) mesh.z[center] - mesh.z[previous];
+
+    const double along = toX * lineX + toZ * lineZ, lengthSquared = lineX * lineX + lineZ * lineZ;
+    if (along <= 0 || along >= lengthSquared)
+        return false;
+
+    const double cross = toX * lineZ - toZ * lineX;
+    return cross * cross <= (double) maxError * maxError * lengthSquared;
+}
+
+/// <summary>
+///     Measures the input vertex p against the triangle a, b, c: the distance of p outside of the triangle in the XZ
+///     plane, zero when it lies inside, and the height of p above or below the plane of the triangle.
+/// </summary>
+static void Deviation(const NavMeshData &mesh, const int a, const int b, const int c, const int p, double &outside,
+                      double &height) {
+    const double x1 = (double) mesh.x[b] - mesh.x[a], y1 = (double) mesh.y[b] - mesh.y[a],
+            z1 = (double) mesh.z[b] - mesh.z[a];
+    const double x2 = (double) mesh.x[c] - mesh.x[a], y2 = (double) mesh.y[c] - mesh.y[a],
+            z2 = (double) mesh.z[c] - mesh.z[a];
+
+    const double determinant = x1 * z2 - x2 * z1;
+    const double slopeX = (y1 * z2 - y2 * z1) / determinant, slopeZ = (x1 * y2 - x2 * y1) / determinant;
+    height = fabs(mesh.y[a] + slopeX * ((double) mesh.x[p] - mesh.x[a]) + slopeZ * ((double) mesh.z[p] - mesh.z[a]) -
+                  mesh.y[p]);
+
+    const int corners[3] = {a, b, c};
+    const double winding = Predicates::Orient2D(mesh.XZ(a), mesh.XZ(b), mesh.XZ(c));
+    bool inside = true;
+    outside = INFINITY;
+    for (int k = 0; k < 3; k++) {
+        const int from = corners[k], to = corners[(k + 1) % 3];
+        inside = inside && Predicates::Orient2D(mesh.XZ(from), mesh.XZ(to), mesh.XZ(p)) * winding >= 0;
+
+        const double edgeX = (double) mesh.x[to] - mesh.x[from], edgeZ = (double) mesh.z[to] - mesh.z[from];
+        const double toX = (double) mesh.x[p] - mesh.x[from], toZ = (double) mesh.z[p] - mesh.z[from];
+        const double along = clamp((toX * edgeX + toZ * edgeZ) / (edgeX * edgeX + edgeZ * edgeZ), 0.0, 1.0);
+        outside = min(outside, hypot(toX - along * edgeX, toZ - along * edgeZ));
+    }
+
+    if (inside)
+        outside = 0;
+}
+
+int MeshDecimator::Decimate(NavMeshData &mesh, const float maxError, pmr::memory_resource *memory) {
+    PROFILE_SCOPE("Decimate");
+
+    const int vertexCount = mesh.VertexCount(), triangleCount = mesh.TriangleCount();
+    vector<int> &indices = mesh.indices;
+
+    pmr::vector<pmr::vector<int>> fans = pmr::vector<pmr::vector<int>>(vertexCount, memory);
+    for (int i = 0; i < triangleCount * 3; i++)
+        fans[indices[i]].push_back(i / 3);
+
+    //Only the sign is kept, collapses never flip a triangle.
+    pmr::vector<double> winding = pmr::vector<double>(triangleCount, memory);
+    for (int t = 0; t < triangleCount; t++)
+        winding[t] = Predicates::Orient2D(mesh.XZ(indices[t * 3]), mesh.XZ(indices[t * 3 + 1]),
+                                          mesh.XZ(indices[t * 3 + 2]));
+
+    pmr::vector<uint8_t> dead = pmr::vector<uint8_t>(triangleCount, 0, memory);
+    pmr::vector<int> ring = pmr::vector<int>(memory), edgeUses = pmr::vector<int>(memory);
+    pmr::vector<int> targets = pmr::vector<int>(memory), targetRing = pmr::vector<int>(memory);
+
+    //Input vertices removed so far, each kept by the triangle that covers it, so every collapse is measured against
+    //the input heights and outline instead of the already simplified surface.
+    pmr::vector<pmr::vector<int>> covered = pmr::vector<pmr::vector<int>>(triangleCount, memory);
+    pmr::vector<int> points = pmr::vector<int>(memory), owners = pmr::vector<int>(memory);
+
+    auto contains = [&](const int t, const int v) {
+        return indices[t * 3] == v || indices[t * 3 + 1] == v || indices[t * 3 + 2] == v;
+    };
+
+    auto collectRing = [&](pmr::vector<int> &fan, const int center, pmr::vector<int> &out) {
+        fan.erase(remove_if(fan.begin(), fan.end(), [&](const int t) { return dead[t] != 0; }), fan.end());
+
+        out.clear();
+        edgeUses.clear();
+        for (const int t: fan) {
+            for (int k = 0; k < 3; k++) {
+                const int w = indices[t * 3 + k];
+                if (w == center)
+                    continue;
+
+                auto found = find(out.begin(), out.end(), w);
+                if (found == out.end()) {
+                    out.push_back(w);
+                    edgeUses.push_back(1);
+                } else
+                    edgeUses[found - out.begin()]++;
+            }
+        }
+    };
+
+    auto tryCollapse = [&](const int u) {
+        pmr::vector<int> &fan = fans[u];
+        collectRing(fan, u, ring);
+        if (fan.empty())
+            return false;
+
+        for (const int t: fan) {
+            if (winding[t] == 0)
+                return false;
+        }
+
+        //Edges used once are on the boundary, edges used more than twice make the fan non-manifold.
+        targets.clear();
+        for (int i = 0; i < (int) ring.size(); i++) {
+            if (edgeUses[i] > 2)
+                return false;
+            if (edgeUses[i] == 1)
+                targets.push_back(ring[i]);
+        }
+
+        //A boundary vertex with a single triangle is a corner of the outline or an island, not a point along it.
+        if (targets.size() == 2) {
+            if (fan.size() < 2 || !Straight(mesh, targets[0], u, targets[1], maxError))
+                return false;
+        } else if (targets.empty())
+            targets.assign(ring.begin(), ring.end());
+        else
+            return false;
+
+        if (!Flat(mesh, fan, ring, u, maxError))
+            return false;
+
+        auto lengthSquared = [&](const int v) {
+            const double dx = (double) mesh.x[v] - mesh.x[u], dy = (double) mesh.y[v] - mesh.y[u],
+                    dz = (double) mesh.z[v] - mesh.z[u];
+            return dx * dx + dy * dy + dz * dz;
+        };
+        stable_sort(targets.begin(), targets.end(),
+                    [&](const int a, const int b) { return lengthSquared(a) < lengthSquared(b); });
+
+        for (const int v: targets) {
+            //The vertices next to both ends must be exactly those across the collapsed edge, or the fan would fold
+            //onto the triangles of v.
+            collectRing(fans[v], v, targetRing);
+            int shared = 0, across = 0;
+            for (const int w: ring)
+                shared += find(targetRing.begin(), targetRing.end(), w) != targetRing.end();
+            for (const int t: fan)
+                across += contains(t, v);
+
+            if (shared != across)
+                continue;
+
+            bool valid = true;
+            for (int i = 0; i < (int) fan.size() && valid; i++) {
+                const int t = fan[i];
+                if (contains(t, v))
+                    continue;
+
+                auto corner = [&](const int k) { return mesh.XZ(indices[t * 3 + k] == u ? v : indices[t * 3 + k]); };
+                const double orientation = Predicates::Orient2D(corner(0), corner(1), corner(2));
+                valid = orientation * winding[t] > 0;
+            }
+
+            if (!valid)
+                continue;
+
+            //u and the vertices removed under the fan must stay within maxError of the triangles that remain.
+            points.assign(1, u);
+            for (const int t: fan)
+                points.insert(points.end(), covered[t].begin(), covered[t].end());
+
+            owners.assign(points.size(), -1);
+            for (int i = 0; i < (int) points.size() && valid; i++) {
+                double closest = INFINITY, closestHeight = INFINITY;
+                for (const int t: fan) {
+                    if (contains(t, v))
+                        continue;
+
+                    auto corner = [&](const int k) { return indices[t * 3 + k] == u ? v : indices[t * 3 + k]; };
+                    double outside, height;
+                    Deviation(mesh, corner(0), corner(1), corner(2), points[i], outside, height);
+                    if (outside < closest) {
+                        closest = outside;
+                        closestHeight = height;
+                        owners[i] = t;
+                    }
+                }
+
+                valid = closest <= maxError && closestHeight <= maxError;
+            }
+
+            if (!valid)
+                continue;
+
+            for (const int t: fan) {
+                covered[t].clear();
+                if (contains(t, v)) {
+                    dead[t] = 1;
+                    continue;
+                }
+
+                for (int k = 0; k < 3; k++) {
+                    if (indices[t * 3 + k] == u)
+                        indices[t * 3 + k] = v;
+                }
+                fans[v].push_back(t);
+            }
+
+            for (int i = 0; i < (int) points.size(); i++)
+                covered[owners[i]].push_back(points[i]);
+
+            fan.clear();
+            return true;
+        }
+
+        return false;
+    };
+
+    int removed = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int u = 0; u < vertexCount; u++) {
+            if (tryCollapse(u)) {
+                removed++;
+                changed = true;
+            }
+        }
+    }
+
+    vector<int> live = vector<int>();
+    for (int t = 0; t < triangleCount; t++) {
+        if (!dead[t])
+            live.push_back(t);
+    }
+
+    PROFILE_COUNT("Decimated vertices", removed);
+    PROFILE_COUNT("Decimated triangles", triangleCount - (int) live.size());
+
+    mesh = mesh.Extract(live, memory);
+    return removed;
+}
@@ -0,0 +1,36 @@
+#ifndef CPPOPTIMIZER_MESHDECIMATOR_H
+#define CPPOPTIMIZER_MESHDECIMATOR_H
+
+#include <memory_resource>
+#include <vector>
+#include "NavMeshData.h"
+
+using namespace std;
+
+/// <summary>
+///     Cuts the triangle count by collapsing vertices into a neighbor where the surface is flat.
+///     A vertex is removed when every vertex around it lies within the error bound of the plane of every triangle
+///     around it, so the triangles it joins are coplanar and the merged area can be triangulated again without it.
+///     Boundary vertices are only collapsed along the boundary, and only when they lie within the error bound of
+///     the line through their two boundary neighbors, so the outline keeps its shape. Neighbors are tried shortest
+///     edge first, and a collapse is taken only when the fan stays manifold and no triangle flips or degenerates
+///     in the XZ plane, tested with the exact orientation predicate. Triangles that are degenerate in the XZ plane,
+///     such as the stitches of the hole filler, keep their vertices.
+///     Vertices are visited in id order in passes until a pass removes nothing, so the result is deterministic.
+///     Each triangle keeps the input vertices removed under it, and a collapse is only taken when all of them and
+///     the collapsed vertex stay within the error bound of the new triangles, both in height and outside of them in
+///     the XZ plane. So the bound holds at every input vertex however many collapses touch the same area.
+/// </summary>
+class MeshDecimator {
+public:
+    /// <summary>
+    ///     Decimates the indices in place, then drops the triangles and vertices that are no longer used.
+    /// </summary>
+    /// <param name="maxError">Largest height and outline change allowed at any input vertex.</param>
+    /// <param name="memory">Resource for the temporary lists.</param>
+    /// <returns>Number of vertices that were collapsed.</returns>
+    static int Decimate(NavMeshData &mesh, float maxError, pmr::memory_resource *memory = pmr::get_default_resource());
+};
+
+
+#endif //CPPOPTIMIZER_MESHDECIMATOR_H
@@ -0,0 +1,478 @@
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "NavMeshBinary.h"
+#include "TriangleLocator.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static_assert(sizeof(NavMeshBinaryHeader) % NavMeshBinary::alignment == 0,
+              "Sections must start aligned after the header");
+
+static uint64_t Align(const uint64_t offset) {
+    return (offset + NavMeshBinary::alignment - 1) / NavMeshBinary::alignment * NavMeshBinary::alignment;
+}
+
+/// <summary>
+///     Reserves an aligned section of count elements at the end of the file layout and returns its offset.
+/// </summary>
+template<typename T>
+static uint64_t AddSection(uint64_t &fileSize, const size_t count) {
+    uint64_t offset = Align(fileSize);
+    fileSize = offset + count * sizeof(T);
+    return offset;
+}
+
+/// <summary>
+///     True when every value lies in [low, high), so ids index inside the counts they refer to.
+/// </summary>
+static bool InRange(const int32_t *values, const uint64_t count, const int64_t low, const int64_t high) {
+    for (uint64_t i = 0; i < count; i++) {
+        if (values[i] < low || values[i] >= high)
+            return false;
+    }
+    return true;
+}
+
+/// <summary>
+///     True when the start table of a CSR section ascends from 0 to the item count.
+/// </summary>
+static bool Ascending(const int32_t *values, const uint64_t count, const int64_t itemCount) {
+    if (values[0] != 0 || values[count - 1] != itemCount)
+        return false;
+    for (uint64_t i = 1; i < count; i++) {
+        if (values[i] < values[i - 1])
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+static void CopySection(vector<unsigned char> &image, const uint64_t offset, const T *source, const size_t count) {
+    if (count > 0)
+        memcpy(image.data() + offset, source, count * sizeof(T));
+}
+
+void NavMeshBinary::Write(const filesystem::path &file, const vector<float> &cleanPoint, const NavMeshData &mesh,
+                          const int finalVertexCount, const int finalIndicesCount, const int finalTriangleCount,
+                          const bool withNeighbors, const float bucketCellSize,
+                          const NavMeshHierarchy *hierarchy) {
+    NavMeshBinaryHeader header = NavMeshBinaryHeader();
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.headerSize = sizeof(NavMeshBinaryHeader);
+    header.vertexCount = (uint32_t) mesh.VertexCount();
+    header.indexCount = (uint32_t) mesh.indices.size();
+    header.finalVertexCount = finalVertexCount;
+    header.finalIndicesCount = finalIndicesCount;
+    header.finalTriangleCount = finalTriangleCount;
+    for (int i = 0; i < 3; i++)
+        header.cleanPoint[i] = cleanPoint[i];
+
+    vector<int32_t> neighbors = vector<int32_t>();
+    if (withNeighbors) {
+        header.flags |= hasNeighbors;
+        neighbors.reserve(mesh.triangles.size() * 3);
+        for (const NavMeshTriangle &triangle: mesh.triangles) {
+            for (int i = 0; i < 3; i++)
+                neighbors.push_back(i < triangle.neighborCount() ? triangle.neighbor(i) : -1);
+        }
+    }
+
+    vector<int32_t> bucketStart = vector<int32_t>(), bucketItems = vector<int32_t>();
+    if (bucketCellSize > 0 && mesh.TriangleCount() > 0) {
+        header.flags |= hasBuckets;
+
+        TriangleLocator locator = TriangleLocator();
+        locator.Build(mesh, bucketCellSize);
+        bucketStart = locator.CellStart();
+        bucketItems = locator.CellItems();
+
+        header.bucketCellSize = locator.CellSize();
+        header.bucketOriginX = locator.OriginX();
+        header.bucketOriginZ = locator.OriginZ();
+        header.bucketWidth = locator.Width();
+        header.bucketHeight = locator.Height();
+        header.bucketItemCount = (uint32_t) bucketItems.size();
+    }
+
+    if (hierarchy != nullptr && !hierarchy->Empty()) {
+        header.flags |= hasHierarchy;
+        header.hierarchyClusterSize = hierarchy->ClusterSize();
+        header.hierarchyClusterCount = (uint32_t) hierarchy->ClusterCount();
+        header.hierarchyEntranceCount = (uint32_t) hierarchy->Entrances().size();
+        header.hierarchyTreeSize = (uint32_t) hierarchy->TreeNext().size();
+        header.hierarchyEdgeCount = (uint32_t) hierarchy->EdgeTargets().size();
+    }
+
+    uint64_t fileSize = sizeof(NavMeshBinaryHeader);
+    header.xOffset = AddSection<float>(fileSize, mesh.x.size());
+    header.yOffset = AddSection<float>(fileSize, mesh.y.size());
+    header.zOffset = AddSection<float>(fileSize, mesh.z.size());
+    header.indicesOffset = AddSection<int32_t>(fileSize, mesh.indices.size());
+    if (header.flags & hasNeighbors)
+        header.neighborsOffset = AddSection<int32_t>(fileSize, neighbors.size());
+    if (header.flags & hasBuckets) {
+        header.bucketStartOffset = AddSection<int32_t>(fileSize, bucketStart.size());
+        header.bucketItemsOffset = AddSection<int32_t>(fileSize, bucketItems.size());
+    }
+    if (header.flags & hasHierarchy) {
+        header.clustersOffset = AddSection<int32_t>(fileSize, hierarchy->Clusters().size());
+        header.localIndicesOffset = AddSection<int32_t>(fileSize, hierarchy->LocalIndices().size());
+        header.entranceStartOffset = AddSection<int32_t>(fileSize, hierarchy->EntranceStart().size());
+        header.entrancesOffset = AddSection<int32_t>(fileSize, hierarchy->Entrances().size());
+        header.treeOffsetsOffset = AddSection<int32_t>(fileSize, hierarchy->TreeOffsets().size());
+        header.treeNextOffset = AddSection<int32_t>(fileSize, hierarchy->TreeNext().size());
+        header.treeCostsOffset = AddSection<float>(fileSize, hierarchy->TreeCosts().size());
+        header.edgeStartOffset = AddSection<int32_t>(fileSize, hierarchy->EdgeStart().size());
+        header.edgeTargetsOffset = AddSection<int32_t>(fileSize, hierarchy->EdgeTargets().size());
+        header.edgeCostsOffset = AddSection<float>(fileSize, hierarchy->EdgeCosts().size());
+    }
+    header.fileSize = fileSize;
+
+    vector<unsigned char> image = vector<unsigned char>(fileSize, 0);
+    memcpy(image.data(), &header, sizeof(header));
+    CopySection(image, header.xOffset, mesh.x.data(), mesh.x.size());
+    CopySection(image, header.yOffset, mesh.y.data(), mesh.y.size());
+    CopySection(image, header.zOffset, mesh.z.data(), mesh.z.size());
+    CopySection(image, header.indicesOffset, mesh.indices.data(), mesh.indices.size());
+    if (header.flags & hasNeighbors)
+        CopySection(image, header.neighborsOffset, neighbors.data(), neighbors.size());
+    if (header.flags & hasBuckets) {
+        CopySection(image, header.bucketStartOffset, bucketStart.data(), bucketStart.size());
+        CopySection(image, header.bucketItemsOffset, bucketItems.data(), bucketItems.size());
+    }
+    if (header.flags & hasHierarchy) {
+        auto copy = [&](const uint64_t offset, const auto &table) {
+            CopySection(image, offset, table.data(), table.size());
+        };
+        copy(header.clustersOffset, hierarchy->Clusters());
+        copy(header.localIndicesOffset, hierarchy->LocalIndices());
+        copy(header.entranceStartOffset, hierarchy->EntranceStart());
+        copy(header.entrancesOffset, hierarchy->Entrances());
+        copy(header.treeOffsetsOffset, hierarchy->TreeOffsets());
+        copy(header.treeNextOffset, hierarchy->TreeNext());
+        copy(header.treeCostsOffset, hierarchy->TreeCosts());
+        copy(header.edgeStartOffset, hierarchy->EdgeStart());
+        copy(header.edgeTargetsOffset, hierarchy->EdgeTargets());
+        copy(header.edgeCostsOffset, hierarchy->EdgeCosts());
+    }
+
+    ofstream str(file, ios::binary);
+    if (!str.write((const char *) image.data(), (streamsize) image.size()))
+        throw runtime_error("could not write " + file.string());
+}
+
+void NavMeshBinary::Write(const filesystem::path &file, NavMeshImport &navMeshImport) {
+    NavMeshData mesh = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+    Write(file, navMeshImport.getCleanPoint(), mesh, navMeshImport.FV(), navMeshImport.FI(), navMeshImport.FT(),
+          false, 0);
+}
+
+NavMeshBinaryView::NavMeshBinaryView(const filesystem::path &file) {
+    data_ = nullptr;
+    size_ = 0;
+
+#ifdef _WIN32
+    file_ = CreateFileW(file.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    mapping_ = nullptr;
+    LARGE_INTEGER size;
+    if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+        throw runtime_error("could not open " + file.string());
+    }
+
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ != nullptr)
+        data_ = (const unsigned char *) MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (data_ == nullptr) {
+        if (mapping_ != nullptr)
+            CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw runtime_error("could not map " + file.string());
+    }
+    size_ = (size_t) size.QuadPart;
+#else
+    int descriptor = open(file.c_str(), O_RDONLY);
+    struct stat status = {};
+    if (descriptor == -1 || fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        if (descriptor != -1)
+            close(descriptor);
+        throw runtime_error("could not open " + file.string());
+    }
+
+    void *mapped = mmap(nullptr, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapped == MAP_FAILED)
+        throw runtime_error("could not map " + file.string());
+
+    data_ = (const unsigned char *) mapped;
+    size_ = (size_t) status.st_size;
+#endif
+
+    try {
+        Validate(file);
+    }
+    catch (...) {
+        Unmap();
+        throw;
+    }
+}
+
+NavMeshBinaryView::~NavMeshBinaryView() {
+    Unmap();
+}
+
+void NavMeshBinaryView::Unmap() {
+    if (data_ == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+#else
+    munmap((void *) data_, size_);
+#endif
+    data_ = nullptr;
+}
+
+void NavMeshBinaryView::Validate(const filesystem::path &file) const {
+    const string name = file.string();
+    if (size_ < sizeof(NavMeshBinaryHeader))
+        throw runtime_error(name + " is too small for a navigation mesh header");
+
+    const NavMeshBinaryHeader &header = Header();
+    if (memcmp(header.magic, NavMeshBinary::magic, sizeof(NavMeshBinary::magic)) != 0)
+        throw runtime_error(name + " is not a binary navigation mesh");
+    if (header.version != NavMeshBinary::version || header.headerSize != sizeof(NavMeshBinaryHeader))
+        throw runtime_error(name + " has unsupported version " + to_string(header.version));
+    if (header.fileSize != size_)
+        throw runtime_error(name + " is truncated");
+    if (header.indexCount % 3 != 0)
+        throw runtime_error(name + " has an index count that is not a multiple of 3");
+
+    auto check = [&](const uint64_t offset, const uint64_t bytes, const bool required) {
+        if (offset == 0 && !required)
+            return;
+        if (offset < sizeof(NavMeshBinaryHeader) || offset % NavMeshBinary::alignment != 0 || offset > size_ ||
+            bytes > size_ - offset)
+            throw runtime_error(name + " has a section outside the file");
+    };
+
+    //Sections are only checked when their flag is set, so the offsets of absent ones must be 0.
+    if ((!(header.flags & NavMeshBinary::hasNeighbors) && header.neighborsOffset != 0) ||
+        (!(header.flags & NavMeshBinary::hasBuckets) &&
+         (header.bucketStartOffset != 0 || header.bucketItemsOffset != 0)) ||
+        (!(header.flags & NavMeshBinary::hasHierarchy) &&
+         (header.clustersOffset != 0 || header.localIndicesOffset != 0 || header.entranceStartOffset != 0 ||
+          header.entrancesOffset != 0 || header.treeOffsetsOffset != 0 || header.treeNextOffset != 0 ||
+          header.treeCostsOffset != 0 || header.edgeStartOffset != 0 || header.edgeTargetsOffset != 0 ||
+          header.edgeCostsOffset != 0)))
+        throw runtime_error(name + " has a section its flags do not announce");
+
+    check(header.xOffset, header.vertexCount * (uint64_t) sizeof(float), true);
+    check(header.yOffset, header.vertexCount * (uint64_t) sizeof(float), true);
+    check(header.zOffset, header.vertexCount * (uint64_t) sizeof(float), true);
+    check(header.indicesOffset, header.indexCount * (uint64_t) sizeof(int32_t), true);
+    check(header.neighborsOffset, header.indexCount * (uint64_t) sizeof(int32_t),
+          (header.flags & NavMeshBinary::hasNeighbors) != 0);
+
+    if (header.flags & NavMeshBinary::hasBuckets) {
+        if (header.bucketWidth <= 0 || header.bucketHeight <= 0 || header.bucketCellSize <= 0)
+            throw runtime_error(name + " has an empty bucket grid");
+
+        check(header.bucketStartOffset,
+              ((uint64_t) header.bucketWidth * header.bucketHeight + 1) * sizeof(int32_t), true);
+        check(header.bucketItemsOffset, header.bucketItemCount * (uint64_t) sizeof(int32_t), true);
+    }
+
+    //Ids are checked against the counts they index, so no accessor can read outside the sections.
+    const int64_t vertexCount = header.vertexCount, triangleCount = header.indexCount / 3;
+    if (!InRange(Indices(), header.indexCount, 0, vertexCount))
+        throw runtime_error(name + " has a vertex index out of range");
+    if ((header.flags & NavMeshBinary::hasNeighbors) && !InRange(Neighbors(), header.indexCount, -1, triangleCount))
+        throw runtime_error(name + " has a neighbor id out of range");
+    if ((header.flags & NavMeshBinary::hasBuckets) &&
+        (!Ascending(BucketStart(), (uint64_t) header.bucketWidth * header.bucketHeight + 1, header.bucketItemCount) ||
+         !InRange(BucketItems(), header.bucketItemCount, 0, triangleCount)))
+        throw runtime_error(name + " has a spatial bucket out of range");
+
+    if (header.flags & NavMeshBinary::hasHierarchy) {
+        if (header.hierarchyClusterCount == 0 || header.hierarchyClusterSize <= 0)
+            throw runtime_error(name + " has an empty cluster hierarchy");
+
+        const uint64_t triangleCount = header.indexCount / 3;
+        check(header.clustersOffset, triangleCount * sizeof(int32_t), true);
+        check(header.localIndicesOffset, triangleCount * sizeof(int32_t), true);
+        check(header.entranceStartOffset, (header.hierarchyClusterCount + (uint64_t) 1) * sizeof(int32_t), true);
+        check(header.entrancesOffset, header.hierarchyEntranceCount * (uint64_t) sizeof(int32_t), true);
+        check(header.treeOffsetsOffset, triangleCount * sizeof(int32_t), true);
+        check(header.treeNextOffset, header.hierarchyTreeSize * (uint64_t) sizeof(int32_t), true);
+        check(header.treeCostsOffset, header.hierarchyTreeSize * (uint64_t) sizeof(float), true);
+        check(header.edgeStartOffset, (triangleCount + 1) * sizeof(int32_t), true);
+        check(header.edgeTargetsOffset, header.hierarchyEdgeCount * (uint64_t) sizeof(int32_t), true);
+        check(header.edgeCostsOffset, header.hierarchyEdgeCount * (uint64_t) sizeof(float), true);
+        ValidateHierarchy(name);
+    }
+}
+
+void NavMeshBinaryView::ValidateHierarchy(const string &name) const {
+    const NavMeshBinaryHeader &header = Header();
+    const int64_t triangleCount = header.indexCount / 3, clusterCount = header.hierarchyClusterCount,
+            treeSize = header.hierarchyTreeSize;
+    const int32_t *clusters = Clusters(), *local = LocalIndices(), *entranceStart = EntranceStart(),
+            *entrances = Entrances(), *treeOffsets = TreeOffsets(), *treeNext = TreeNext();
+
+    if (!InRange(clusters, triangleCount, 0, clusterCount) ||
+        !Ascending(entranceStart, clusterCount + 1, header.hierarchyEntranceCount) ||
+        !InRange(entrances, header.hierarchyEntranceCount, 0, triangleCount) ||
+        !InRange(treeOffsets, triangleCount, -1, treeSize + 1) ||
+        !InRange(treeNext, treeSize, -1, triangleCount) ||
+        !Ascending(EdgeStart(), triangleCount + 1, header.hierarchyEdgeCount) ||
+        !InRange(EdgeTargets(), header.hierarchyEdgeCount, 0, triangleCount))
+        throw runtime_error(name + " has a cluster hierarchy id out of range");
+
+    //Local indices must number the triangles of each cluster, so a tree holds one entry per triangle of its
+    //cluster, and trees only lead to triangles of their own cluster.
+    vector<int64_t> clusterSizes = vector<int64_t>(clusterCount, 0);
+    for (int64_t t = 0; t < triangleCount; t++)
+        clusterSizes[clusters[t]]++;
+    for (int64_t t = 0; t < triangleCount; t++) {
+        if (local[t] < 0 || local[t] >= clusterSizes[clusters[t]])
+            throw runtime_error(name + " has a cluster hierarchy id out of range");
+    }
+
+    auto hasTree = [&](const int32_t t) {
+        return treeOffsets[t] != -1 && treeOffsets[t] + clusterSizes[clusters[t]] <= treeSize;
+    };
+
+    for (int64_t c = 0; c < clusterCount; c++) {
+        for (int32_t i = entranceStart[c]; i < entranceStart[c + 1]; i++) {
+            const int32_t entrance = entrances[i];
+            if (clusters[entrance] != c || !hasTree(entrance))
+                throw runtime_error(name + " has a cluster hierarchy tree out of range");
+
+            for (int64_t j = 0; j < clusterSizes[c]; j++) {
+                const int32_t next = treeNext[treeOffsets[entrance] + j];
+                if (next != -1 && clusters[next] != c)
+                    throw runtime_error(name + " has a cluster hierarchy tree out of range");
+            }
+        }
+    }
+
+    for (uint32_t e = 0; e < header.hierarchyEdgeCount; e++) {
+        if (!hasTree(EdgeTargets()[e]))
+            throw runtime_error(name + " has a cluster hierarchy tree out of range");
+    }
+}
+
+const NavMeshBinaryHeader &NavMeshBinaryView::Header() const {
+    return *reinterpret_cast<const NavMeshBinaryHeader *>(data_);
+}
+
+int NavMeshBinaryView::VertexCount() const {
+    return (int) Header().vertexCount;
+}
+
+int NavMeshBinaryView::IndexCount() const {
+    return (int) Header().indexCount;
+}
+
+int NavMeshBinaryView::TriangleCount() const {
+    return (int) Header().indexCount / 3;
+}
+
+const float *NavMeshBinaryView::X() const {
+    return Section<float>(Header().xOffset);
+}
+
+const float *NavMeshBinaryView::Y() const {
+    return Section<float>(Header().yOffset);
+}
+
+const float *NavMeshBinaryView::Z() const {
+    return Section<float>(Header().zOffset);
+}
+
+const int32_t *NavMeshBinaryView::Indices() const {
+    return Section<int32_t>(Header().indicesOffset);
+}
+
+const int32_t *NavMeshBinaryView::Neighbors() const {
+    return Section<int32_t>(Header().neighborsOffset);
+}
+
+const int32_t *NavMeshBinaryView::BucketStart() const {
+    return Section<int32_t>(Header().bucketStartOffset);
+}
+
+const int32_t *NavMeshBinaryView::BucketItems() const {
+    return Section<int32_t>(Header().bucketItemsOffset);
+}
+
+const int32_t *NavMeshBinaryView::Clusters() const {
+    return Section<int32_t>(Header().clustersOffset);
+}
+
+const int32_t *NavMeshBinaryView::LocalIndices() const {
+    return Section<int32_t>(Header().localIndicesOffset);
+}
+
+const int32_t *NavMeshBinaryView::EntranceStart() const {
+    return Section<int32_t>(Header().entranceStartOffset);
+}
+
+const int32_t *NavMeshBinaryView::Entrances() const {
+    return Section<int32_t>(Header().entrancesOffset);
+}
+
+const int32_t *NavMeshBinaryView::TreeOffsets() const {
+    return Section<int32_t>(Header().treeOffsetsOffset);
+}
+
+const int32_t *NavMeshBinaryView::TreeNext() const {
+    return Section<int32_t>(Header().treeNextOffset);
+}
+
+const float *NavMeshBinaryView::TreeCosts() const {
+    return Section<float>(Header().treeCostsOffset);
+}
+
+const int32_t *NavMeshBinaryView::EdgeStart() const {
+    return Section<int32_t>(Header().edgeStartOffset);
+}
+
+const int32_t *NavMeshBinaryView::EdgeTargets() const {
+    return Section<int32_t>(Header().edgeTargetsOffset);
+}
+
+const float *NavMeshBinaryView::EdgeCosts() const {
+    return Section<float>(Header().edgeCostsOffset);
+}
+
+NavMeshImport NavMeshBinaryView::ToImport() const {
+    const NavMeshBinaryHeader &header = Header();
+
+    vector<Vector3> vertices = vector<Vector3>();
+    vertices.reserve(VertexCount());
+    const float *x = X(), *y = Y(), *z = Z();
+    for (int i = 0; i < VertexCount(); i++)
+        vertices.emplace_back(x[i], y[i], z[i]);
+
+    return {vector<float>(header.cleanPoint, header.cleanPoint + 3), std::move(vertices),
+            vector<int>(Indices(), Indices() + IndexCount()),
+            header.finalVertexCount, header.finalIndicesCount, header.finalTriangleCount};
+}
@@ -0,0 +1,173 @@
+#ifndef CPPOPTIMIZER_NAVMESHBINARY_H
+#define CPPOPTIMIZER_NAVMESHBINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "NavMeshData.h"
+#include "NavMeshHierarchy.h"
+#include "NavMeshImport.h"
+
+using namespace std;
+
+/// <summary>
+///     Fixed size header at the start of a binary navigation mesh file.
+///     Every section is a contiguous native endian array starting at a multiple of NavMeshBinary::alignment from
+///     the file start, so a mapped file can be read in place. Offsets of absent sections are 0.
+/// </summary>
+struct alignas(64) NavMeshBinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t flags;
+
+    uint32_t vertexCount, indexCount;
+    int32_t finalVertexCount, finalIndicesCount, finalTriangleCount;
+    float cleanPoint[3];
+
+    /// <summary>
+    ///     Triangles by every grid cell they overlap, as built by TriangleLocator. The grid starts at cell (bucketOriginX,
+    ///     bucketOriginZ), counted in whole cells from the world origin, and the triangles of cell (x, z) are
+    ///     bucketItems[bucketStart[z * bucketWidth + x]] up to bucketItems[bucketStart[z * bucketWidth + x + 1]].
+    /// </summary>
+    float bucketCellSize;
+    int32_t bucketOriginX, bucketOriginZ, bucketWidth, bucketHeight;
+    uint32_t bucketItemCount;
+
+    /// <summary>
+    ///     Cluster hierarchy as built by NavMeshHierarchy, the sections hold its tables as they are. Clusters and
+    ///     local indices have one entry per triangle, tree offsets and edge starts one per triangle and a final
+    ///     one for the edges, entrance starts one per cluster and a final one.
+    /// </summary>
+    float hierarchyClusterSize;
+    uint32_t hierarchyClusterCount, hierarchyEntranceCount, hierarchyTreeSize, hierarchyEdgeCount;
+
+    uint64_t xOffset, yOffset, zOffset, indicesOffset;
+
+    /// <summary>
+    ///     Three neighbor triangle ids per triangle, -1 for an open edge.
+    /// </summary>
+    uint64_t neighborsOffset;
+    uint64_t bucketStartOffset, bucketItemsOffset;
+    uint64_t clustersOffset, localIndicesOffset, entranceStartOffset, entrancesOffset;
+    uint64_t treeOffsetsOffset, treeNextOffset, treeCostsOffset;
+    uint64_t edgeStartOffset, edgeTargetsOffset, edgeCostsOffset;
+    uint64_t fileSize;
+};
+
+/// <summary>
+///     Writes and converts binary navigation mesh files. Input meshes from NavMeshImport only hold the vertex and
+///     index sections, optimized meshes add the neighbor table, the spatial buckets and the cluster hierarchy.
+/// </summary>
+class NavMeshBinary {
+public:
+    static constexpr char magic[4] = {'N', 'A', 'V', 'B'};
+    static constexpr uint32_t version = 2;
+    static constexpr size_t alignment = 64;
+
+    static constexpr uint32_t hasNeighbors = 1, hasBuckets = 2, hasHierarchy = 4;
+
+    /// <summary>
+    ///     Writes the mesh, throws runtime_error when the file can not be written.
+    /// </summary>
+    /// <param name="bucketCellSize">Cell size of the spatial buckets, 0 leaves them out.</param>
+    /// <param name="withNeighbors">Writes the neighbor ids of mesh.triangles, which must be set up.</param>
+    /// <param name="hierarchy">Hierarchy built for the mesh, null or empty leaves it out.</param>
+    static void Write(const filesystem::path &file, const vector<float> &cleanPoint, const NavMeshData &mesh,
+                      int finalVertexCount, int finalIndicesCount, int finalTriangleCount,
+                      bool withNeighbors, float bucketCellSize, const NavMeshHierarchy *hierarchy = nullptr);
+
+    static void Write(const filesystem::path &file, NavMeshImport &navMeshImport);
+};
+
+/// <summary>
+///     Read only memory mapping of a binary navigation mesh file. The accessors point straight into the mapping
+///     and stay valid for the lifetime of the view. The constructor throws runtime_error when the file can not be
+///     mapped or fails validation.
+/// </summary>
+class NavMeshBinaryView {
+private:
+    const unsigned char *data_;
+    size_t size_;
+
+#ifdef _WIN32
+    void *file_, *mapping_;
+#endif
+
+    template<typename T>
+    const T *Section(uint64_t offset) const {
+        return offset == 0 ? nullptr : reinterpret_cast<const T *>(data_ + offset);
+    }
+
+    void Validate(const filesystem::path &file) const;
+
+    /// <summary>
+    ///     Range checks of the hierarchy sections, so the trees and edges the pathfinder follows stay inside them.
+    /// </summary>
+    void ValidateHierarchy(const string &name) const;
+
+    void Unmap();
+
+public:
+    explicit NavMeshBinaryView(const filesystem::path &file);
+
+    ~NavMeshBinaryView();
+
+    NavMeshBinaryView(const NavMeshBinaryView &) = delete;
+
+    NavMeshBinaryView &operator=(const NavMeshBinaryView &) = delete;
+
+    const NavMeshBinaryHeader &Header() const;
+
+    int VertexCount() const;
+
+    int IndexCount() const;
+
+    int TriangleCount() const;
+
+    const float *X() const;
+
+    const float *Y() const;
+
+    const float *Z() const;
+
+    const int32_t *Indices() const;
+
+    /// <returns>Null when the file has no neighbor table.</returns>
+    const int32_t *Neighbors() const;
+
+    /// <returns>Null when the file has no spatial buckets.</returns>
+    const int32_t *BucketStart() const;
+
+    const int32_t *BucketItems() const;
+
+    /// <returns>Null when the file has no cluster hierarchy, the other hierarchy sections are null as well.</returns>
+    const int32_t *Clusters() const;
+
+    const int32_t *LocalIndices() const;
+
+    const int32_t *EntranceStart() const;
+
+    const int32_t *Entrances() const;
+
+    const int32_t *TreeOffsets() const;
+
+    const int32_t *TreeNext() const;
+
+    const float *TreeCosts() const;
+
+    const int32_t *EdgeStart() const;
+
+    const int32_t *EdgeTargets() const;
+
+    const float *EdgeCosts() const;
+
+    /// <summary>
+    ///     Copies the vertices and indices out into a NavMeshImport for the optimization pipeline.
+    /// </summary>
+    NavMeshImport ToImport() const;
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHBINARY_H
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GeometryPolicy.h"
+#include "NavMeshBinary.h"
+#include "NavMeshJsonReader.h"
+#include "NavMeshOptimizer.h"
+#include "NavMeshPathfinder.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+static bool SameMesh(NavMeshImport &navMeshImport, const NavMeshBinaryView &view) {
+    vector<Vector3> &vertices = navMeshImport.getVertices();
+    vector<int> &indices = navMeshImport.getIndices();
+    if ((int) vertices.size() != view.VertexCount() || (int) indices.size() != view.IndexCount())
+        return false;
+
+    for (int i = 0; i < (int) vertices.size(); i++) {
+        if (vertices[i].x != view.X()[i] || vertices[i].y != view.Y()[i] || vertices[i].z != view.Z()[i])
+            return false;
+    }
+    return equal(indices.begin(), indices.end(), view.Indices());
+}
+
+/// <summary>
+///     True when the mesh loaded from the baked file has the same vertices, triangles, links and portals as the
+///     optimized mesh, and the locator the same cells.
+/// </summary>
+static bool SameOptimized(NavMeshOptimized &optimized, NavMeshOptimized &loaded) {
+    const NavMeshData &a = optimized.getMesh(), &b = loaded.getMesh();
+    if (a.x != b.x || a.y != b.y || a.z != b.z || a.indices != b.indices || a.triangles.size() != b.triangles.size())
+        return false;
+
+    for (int t = 0; t < (int) a.triangles.size(); t++) {
+        const NavMeshTriangle &left = a.triangles[t], &right = b.triangles[t];
+        if (left.neighborCount() != right.neighborCount())
+            return false;
+
+        for (int k = 0; k < left.neighborCount(); k++) {
+            if (left.neighbor(k) != right.neighbor(k) || left.portalLeft(k) != right.portalLeft(k) ||
+                left.portalRight(k) != right.portalRight(k) || left.neighborDistance(k) != right.neighborDistance(k))
+                return false;
+        }
+    }
+
+    const TriangleLocator &locatorA = optimized.getTriangleLocator(), &locatorB = loaded.getTriangleLocator();
+    return locatorA.CellSize() == locatorB.CellSize() && locatorA.OriginX() == locatorB.OriginX() &&
+           locatorA.OriginZ() == locatorB.OriginZ() && locatorA.CellStart() == locatorB.CellStart() &&
+           locatorA.CellItems() == locatorB.CellItems();
+}
+
+/// <summary>
+///     True when random queries between triangle centers find the same paths through the hierarchy of the
+///     optimized mesh and through the hierarchy loaded from the baked file.
+/// </summary>
+static bool SamePaths(NavMeshOptimized &optimized, NavMeshOptimized &loaded) {
+    const int queryCount = 1000;
+
+    const NavMeshData &mesh = optimized.getMesh();
+    if (mesh.TriangleCount() == 0)
+        return true;
+
+    const NavMeshPathfinder built = NavMeshPathfinder(mesh, DefaultPolicy::groupSize, &optimized.getHierarchy());
+    const NavMeshPathfinder baked = NavMeshPathfinder(loaded.getMesh(), DefaultPolicy::groupSize,
+                                                      &loaded.getHierarchy());
+
+    auto center = [&mesh](const int t) {
+        const int a = mesh.indices[t * 3], b = mesh.indices[t * 3 + 1], c = mesh.indices[t * 3 + 2];
+        return Vector3((mesh.x[a] + mesh.x[b] + mesh.x[c]) / 3.0f, (mesh.y[a] + mesh.y[b] + mesh.y[c]) / 3.0f,
+                       (mesh.z[a] + mesh.z[b] + mesh.z[c]) / 3.0f);
+    };
+
+    mt19937 random = mt19937(1);
+    uniform_int_distribution<int> triangle = uniform_int_distribution<int>(0, mesh.TriangleCount() - 1);
+    NavMeshPathQuery query = NavMeshPathQuery();
+    vector<Vector3> builtPath = vector<Vector3>(), bakedPath = vector<Vector3>();
+    for (int i = 0; i < queryCount; i++) {
+        const Vector3 start = center(triangle(random)), goal = center(triangle(random));
+        const bool builtFound = built.FindPath(start, goal, query, builtPath);
+        const bool bakedFound = baked.FindPath(start, goal, query, bakedPath);
+        if (builtFound != bakedFound || builtPath != bakedPath)
+            return false;
+    }
+    return true;
+}
+
+/// <summary>
+///     Writes the json import as an input navbin and checks the mapped file against it.
+/// </summary>
+/// <returns>False when the binary file differs, with the reason printed.</returns>
+static bool Convert(const fs::path &file) {
+    fs::path output = fs::path(file).replace_extension(".navbin");
+
+    auto loadStart = high_resolution_clock::now();
+    NavMeshImport navMeshImport = NavMeshJsonReader::Load(file);
+    double loadTime = duration<double, milli>(high_resolution_clock::now() - loadStart).count();
+
+    NavMeshBinary::Write(output, navMeshImport);
+
+    auto mapStart = high_resolution_clock::now();
+    NavMeshBinaryView view = NavMeshBinaryView(output);
+    double mapTime = duration<double, milli>(high_resolution_clock::now() - mapStart).count();
+
+    if (!SameMesh(navMeshImport, view)) {
+        cout << file << ": binary file differs from the json file\n";
+        return false;
+    }
+
+    cout << file.filename().string() << ", " << fs::file_size(file) / 1024 << ", "
+         << fs::file_size(output) / 1024 << ", " << loadTime << ", " << mapTime << "\n";
+    return true;
+}
+
+/// <summary>
+///     Optimizes the json import, bakes it to an optimized navbin and checks the mesh loaded from it.
+/// </summary>
+/// <returns>False when the loaded mesh differs, with the reason printed.</returns>
+static bool Bake(const fs::path &file) {
+    fs::path output = fs::path(file).replace_extension(".optimized.navbin");
+
+    auto loadStart = high_resolution_clock::now();
+    NavMeshImport navMeshImport = NavMeshJsonReader::Load(file);
+    const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0], navMeshImport.getCleanPoint()[1],
+                                       navMeshImport.getCleanPoint()[2]);
+    NavMeshData mesh = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+    NavMeshOptimized optimized = OptimizeNavMesh(cleanPoint, mesh, nullptr);
+    double loadTime = duration<double, milli>(high_resolution_clock::now() - loadStart).count();
+
+    const NavMeshData &result = optimized.getMesh();
+    NavMeshBinary::Write(output, navMeshImport.getCleanPoint(), result, result.VertexCount(),
+                         (int) result.indices.size(), result.TriangleCount(), true, DefaultPolicy::groupSize,
+                         &optimized.getHierarchy());
+
+    auto mapStart = high_resolution_clock::now();
+    NavMeshBinaryView view = NavMeshBinaryView(output);
+    NavMeshOptimized loaded = NavMeshOptimized();
+    loaded.Load(view);
+    double mapTime = duration<double, milli>(high_resolution_clock::now() - mapStart).count();
+
+    if (!SameOptimized(optimized, loaded)) {
+        cout << file << ": baked mesh differs from the optimized mesh\n";
+        return false;
+    }
+    if (!SamePaths(optimized, loaded)) {
+        cout << file << ": baked hierarchy finds other paths than the optimized one\n";
+        return false;
+    }
+
+    cout << file.filename().string() << ", " << fs::file_size(file) / 1024 << ", "
+         << fs::file_size(output) / 1024 << ", " << loadTime << ", " << mapTime << "\n";
+    return true;
+}
+
+/// <summary>
+///     Converts json navigation meshes, given as files or directories of files, to navbin files next to them.
+///     Every written file is mapped back and compared to the json import, and the json load time is reported
+///     against the time to map and validate the binary file. Returns a non zero exit code on any failure.
+///     With --optimized the meshes are optimized first and baked to .optimized.navbin files with the neighbor
+///     table, the spatial buckets and the cluster hierarchy. These are loaded back without running the pipeline
+///     and compared to the optimized mesh, paths through the loaded hierarchy included, and the time to load and
+///     optimize the json is reported against the time to map and load.
+/// </summary>
+int main(int argc, char *argv[]) {
+    vector<fs::path> files = vector<fs::path>();
+    bool optimize = false;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--optimized") {
+            optimize = true;
+            continue;
+        }
+
+        if (!fs::is_directory(argv[i])) {
+            files.emplace_back(argv[i]);
+            continue;
+        }
+
+        vector<fs::path> found = vector<fs::path>();
+        for (const fs::directory_entry &entry: fs::directory_iterator(argv[i])) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json" &&
+                entry.path().stem().extension() != ".optimized")
+                found.push_back(entry.path());
+        }
+        sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+
+    if (files.empty()) {
+        cout << "Usage: NavMeshConvert [--optimized] <directory or json file>...\n";
+        return 1;
+    }
+
+    int failed = 0;
+    if (optimize)
+        cout << "File, Json (KB), Binary (KB), Json load and optimize (ms), Binary map and load (ms)\n";
+    else
+        cout << "File, Json (KB), Binary (KB), Json load (ms), Binary map (ms)\n";
+    for (const fs::path &file: files) {
+        try {
+            if (!(optimize ? Bake(file) : Convert(file)))
+                failed++;
+        }
+        catch (const exception &e) {
+            cout << file << ": failed, " << e.what() << "\n";
+            failed++;
+        }
+    }
+
+    cout << "Converted " << files.size() - failed << " of " << files.size() << " files\n";
+    return failed == 0 ? 0 : 1;
+}
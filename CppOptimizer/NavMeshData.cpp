@@ -0,0 +1,114 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include "NavMeshData.h"
+#include "Profiler.h"
+
+using namespace std;
+
+/// <summary>
+///     Exact position key. Negative zero is stored as zero, as the two compare equal.
+/// </summary>
+static array<uint32_t, 3> PositionKey(float px, float py, float pz) {
+    array<uint32_t, 3> key = array<uint32_t, 3>();
+    px += 0.0f;
+    py += 0.0f;
+    pz += 0.0f;
+    memcpy(&key[0], &px, sizeof(float));
+    memcpy(&key[1], &py, sizeof(float));
+    memcpy(&key[2], &pz, sizeof(float));
+    return key;
+}
+
+struct PositionKeyHash {
+    size_t operator()(const array<uint32_t, 3> &key) const {
+        return ((size_t) key[0] * 73856093u) ^ ((size_t) key[1] * 19349663u) ^ ((size_t) key[2] * 83492791u);
+    }
+};
+
+NavMeshData::NavMeshData() = default;
+
+NavMeshData::NavMeshData(const vector<Vector3> &vertices_in, const vector<int> &indices_in) {
+    Reserve((int) vertices_in.size(), (int) indices_in.size());
+
+    for (const Vector3 &v: vertices_in)
+        AddVertex(v);
+
+    indices = indices_in;
+}
+
+int NavMeshData::VertexCount() const {
+    return (int) x.size();
+}
+
+int NavMeshData::TriangleCount() const {
+    return (int) indices.size() / 3;
+}
+
+Vector3 NavMeshData::Vertex(int i) const {
+    return {x[i], y[i], z[i]};
+}
+
+Vector2 NavMeshData::XZ(int i) const {
+    return {x[i], z[i]};
+}
+
+void NavMeshData::SetVertex(int i, const Vector3 &v) {
+    x[i] = v.x;
+    y[i] = v.y;
+    z[i] = v.z;
+}
+
+int NavMeshData::AddVertex(const Vector3 &v) {
+    x.push_back(v.x);
+    y.push_back(v.y);
+    z.push_back(v.z);
+    return (int) x.size() - 1;
+}
+
+void NavMeshData::Reserve(int vertexCount, int indexCount) {
+    x.reserve(vertexCount);
+    y.reserve(vertexCount);
+    z.reserve(vertexCount);
+    indices.reserve(indexCount);
+    triangles.reserve(indexCount / 3);
+}
+
+void NavMeshData::Clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    indices.clear();
+    triangles.clear();
+}
+
+NavMeshData NavMeshData::Extract(const vector<int> &triangleIds, pmr::memory_resource *memory) const {
+    PROFILE_SCOPE("Extract");
+
+    NavMeshData result = NavMeshData();
+    result.Reserve(VertexCount(), (int) triangleIds.size() * 3);
+
+    //Old id to new id, falling back to the position lookup the first time an old id is seen.
+    pmr::vector<int> remap = pmr::vector<int>(VertexCount(), -1, memory);
+    pmr::unordered_map<array<uint32_t, 3>, int, PositionKeyHash> byPosition =
+            pmr::unordered_map<array<uint32_t, 3>, int, PositionKeyHash>(memory);
+    byPosition.reserve(VertexCount());
+
+    for (const int t: triangleIds) {
+        for (int k = 0; k < 3; k++) {
+            const int old = indices[t * 3 + k];
+
+            if (remap[old] == -1) {
+                auto inserted = byPosition.insert({PositionKey(x[old], y[old], z[old]), result.VertexCount()});
+                if (inserted.second)
+                    result.AddVertex(Vertex(old));
+                remap[old] = inserted.first->second;
+            }
+
+            result.indices.push_back(remap[old]);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,52 @@
+#ifndef CPPOPTIMIZER_NAVMESHDATA_H
+#define CPPOPTIMIZER_NAVMESHDATA_H
+
+#include <memory_resource>
+#include <vector>
+#include "NavMeshTriangle.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace std;
+
+/// <summary>
+///     Mesh container shared by every stage of the optimization pipeline.
+///     Vertex positions are kept as separate contiguous x, y and z arrays, triangles as a flat index array and
+///     the NavMeshTriangles, whose neighbor and width data is stored inline. Stages read and write it in place.
+/// </summary>
+struct NavMeshData {
+    vector<float> x, y, z;
+    vector<int> indices;
+    vector<NavMeshTriangle> triangles;
+
+    NavMeshData();
+
+    NavMeshData(const vector<Vector3> &vertices_in, const vector<int> &indices_in);
+
+    int VertexCount() const;
+
+    int TriangleCount() const;
+
+    Vector3 Vertex(int i) const;
+
+    Vector2 XZ(int i) const;
+
+    void SetVertex(int i, const Vector3 &v);
+
+    int AddVertex(const Vector3 &v);
+
+    void Reserve(int vertexCount, int indexCount);
+
+    void Clear();
+
+    /// <summary>
+    ///     Builds a compacted mesh holding the given triangles in the given order. Vertices are numbered in order
+    ///     of first use and vertices with identical positions are merged into one. The lookups are allocated from
+    ///     the given resource.
+    /// </summary>
+    NavMeshData Extract(const vector<int> &triangleIds,
+                        pmr::memory_resource *memory = pmr::get_default_resource()) const;
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHDATA_H
@@ -0,0 +1,310 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include "NavMeshHierarchy.h"
+#include "NavMeshBinary.h"
+#include "Profiler.h"
+#include "Vector2Int.h"
+
+using namespace std;
+
+static constexpr float unreachable = numeric_limits<float>::infinity();
+
+void NavMeshHierarchy::Build(const NavMeshData &mesh, const float cellSize, const int clusterTriangles) {
+    PROFILE_SCOPE("BuildHierarchy");
+
+    const int triangleCount = mesh.TriangleCount();
+    const vector<int> &indices = mesh.indices;
+
+    clusterSize_ = 0;
+    cluster_.clear();
+    local_.clear();
+    entranceStart_.clear();
+    entrances_.clear();
+    treeOffset_.clear();
+    treeNext_.clear();
+    treeCost_.clear();
+    edgeStart_.clear();
+    edgeTarget_.clear();
+    edgeCost_.clear();
+
+    if (triangleCount == 0 || (int) mesh.triangles.size() != triangleCount || cellSize <= 0)
+        return;
+
+#pragma region Clusters
+
+    vector<float> centerX = vector<float>(triangleCount), centerZ = vector<float>(triangleCount);
+    for (int t = 0; t < triangleCount; t++) {
+        const int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+        centerX[t] = (mesh.x[a] + mesh.x[b] + mesh.x[c]) / 3.0f;
+        centerZ[t] = (mesh.z[a] + mesh.z[b] + mesh.z[c]) / 3.0f;
+    }
+
+    //Doubling the size halves the cell coordinates rounding down, so the cells are found once and the clusters of
+    //every size are counted by shifting the distinct ones. Cells are counted from the lowest one, as the shifts
+    //would never join cells on both sides of 0. Clusters are numbered in order of their cells.
+    vector<Vector2Int> cells = vector<Vector2Int>();
+    for (int t = 0; t < triangleCount; t++)
+        cells.emplace_back((int) floor(centerX[t] / cellSize), (int) floor(centerZ[t] / cellSize));
+
+    Vector2Int lowest = cells[0];
+    for (const Vector2Int &cell: cells)
+        lowest = Vector2Int(min(lowest.x, cell.x), min(lowest.y, cell.y));
+    for (Vector2Int &cell: cells)
+        cell = Vector2Int(cell.x - lowest.x, cell.y - lowest.y);
+
+    vector<Vector2Int> distinct = cells;
+    int shift = 0;
+    for (;; shift++) {
+        sort(distinct.begin(), distinct.end());
+        distinct.erase(unique(distinct.begin(), distinct.end()), distinct.end());
+
+        const int count = (int) distinct.size();
+        if (count * clusterTriangles <= triangleCount || count == 1)
+            break;
+
+        for (Vector2Int &cell: distinct)
+            cell = Vector2Int(cell.x >> 1, cell.y >> 1);
+    }
+    clusterSize_ = ldexp(cellSize, shift);
+
+    cluster_.resize(triangleCount);
+    for (int t = 0; t < triangleCount; t++) {
+        const Vector2Int cell = Vector2Int(cells[t].x >> shift, cells[t].y >> shift);
+        cluster_[t] = (int) (lower_bound(distinct.begin(), distinct.end(), cell) - distinct.begin());
+    }
+
+    const int clusterCount = (int) distinct.size();
+
+    vector<int> clusterStart = vector<int>(clusterCount + 1, 0);
+    for (int t = 0; t < triangleCount; t++)
+        clusterStart[cluster_[t] + 1]++;
+    for (int c = 0; c < clusterCount; c++)
+        clusterStart[c + 1] += clusterStart[c];
+
+    local_.resize(triangleCount);
+    vector<int> fill = vector<int>(clusterStart.begin(), clusterStart.end() - 1);
+    for (int t = 0; t < triangleCount; t++)
+        local_[t] = fill[cluster_[t]]++ - clusterStart[cluster_[t]];
+
+#pragma endregion
+
+#pragma region Entrances
+
+    auto crosses = [&](const int t, const int k) {
+        const NavMeshTriangle &triangle = mesh.triangles[t];
+        return triangle.portalLeft(k) != -1 && cluster_[triangle.neighbor(k)] != cluster_[t];
+    };
+
+    treeOffset_.assign(triangleCount, -1);
+    entranceStart_.assign(clusterCount + 1, 0);
+    for (int t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < mesh.triangles[t].neighborCount(); k++) {
+            if (crosses(t, k)) {
+                treeOffset_[t] = 0;
+                entranceStart_[cluster_[t] + 1]++;
+                break;
+            }
+        }
+    }
+
+    for (int c = 0; c < clusterCount; c++)
+        entranceStart_[c + 1] += entranceStart_[c];
+
+    entrances_.resize(entranceStart_[clusterCount]);
+    fill.assign(entranceStart_.begin(), entranceStart_.end() - 1);
+    for (int t = 0; t < triangleCount; t++) {
+        if (treeOffset_[t] != -1)
+            entrances_[fill[cluster_[t]]++] = t;
+    }
+
+#pragma endregion
+
+#pragma region Shortest path trees inside the clusters
+
+    vector<pair<float, int>> open = vector<pair<float, int>>();
+
+    for (int c = 0; c < clusterCount; c++) {
+        const int size = clusterStart[c + 1] - clusterStart[c];
+
+        for (int i = entranceStart_[c]; i < entranceStart_[c + 1]; i++) {
+            const int entrance = entrances_[i], offset = (int) treeNext_.size();
+            treeOffset_[entrance] = offset;
+            treeNext_.insert(treeNext_.end(), size, -1);
+            treeCost_.insert(treeCost_.end(), size, unreachable);
+
+            treeCost_[offset + local_[entrance]] = 0;
+            open.assign(1, {0.0f, entrance});
+
+            while (!open.empty()) {
+                pop_heap(open.begin(), open.end(), greater<>());
+                const auto [cost, t] = open.back();
+                open.pop_back();
+
+                if (cost > treeCost_[offset + local_[t]])
+                    continue;
+
+                const NavMeshTriangle &triangle = mesh.triangles[t];
+                for (int k = 0; k < triangle.neighborCount(); k++) {
+                    const int n = triangle.neighbor(k);
+                    if (triangle.portalLeft(k) == -1 || cluster_[n] != c)
+                        continue;
+
+                    const float next = cost + triangle.neighborDistance(k);
+                    if (next >= treeCost_[offset + local_[n]])
+                        continue;
+
+                    treeCost_[offset + local_[n]] = next;
+                    treeNext_[offset + local_[n]] = t;
+                    open.emplace_back(next, n);
+                    push_heap(open.begin(), open.end(), greater<>());
+                }
+            }
+        }
+    }
+
+#pragma endregion
+
+#pragma region Abstract graph
+
+    edgeStart_.assign(triangleCount + 1, 0);
+    for (int t = 0; t < triangleCount; t++) {
+        edgeStart_[t] = (int) edgeTarget_.size();
+        if (treeOffset_[t] == -1)
+            continue;
+
+        const NavMeshTriangle &triangle = mesh.triangles[t];
+        for (int k = 0; k < triangle.neighborCount(); k++) {
+            if (!crosses(t, k))
+                continue;
+
+            edgeTarget_.push_back(triangle.neighbor(k));
+            edgeCost_.push_back(triangle.neighborDistance(k));
+        }
+
+        const int c = cluster_[t];
+        for (int i = entranceStart_[c]; i < entranceStart_[c + 1]; i++) {
+            const int other = entrances_[i];
+            const float cost = TreeCost(other, t);
+            if (other == t || cost == unreachable)
+                continue;
+
+            edgeTarget_.push_back(other);
+            edgeCost_.push_back(cost);
+        }
+    }
+    edgeStart_[triangleCount] = (int) edgeTarget_.size();
+
+    PROFILE_COUNT("Hierarchy clusters", clusterCount);
+    PROFILE_COUNT("Hierarchy entrances", entrances_.size());
+    PROFILE_COUNT("Hierarchy edges", edgeTarget_.size());
+
+#pragma endregion
+}
+
+void NavMeshHierarchy::Load(const NavMeshBinaryView &view) {
+    const NavMeshBinaryHeader &header = view.Header();
+    const int triangleCount = view.TriangleCount();
+
+    clusterSize_ = header.hierarchyClusterSize;
+    cluster_.assign(view.Clusters(), view.Clusters() + triangleCount);
+    local_.assign(view.LocalIndices(), view.LocalIndices() + triangleCount);
+    entranceStart_.assign(view.EntranceStart(), view.EntranceStart() + header.hierarchyClusterCount + 1);
+    entrances_.assign(view.Entrances(), view.Entrances() + header.hierarchyEntranceCount);
+    treeOffset_.assign(view.TreeOffsets(), view.TreeOffsets() + triangleCount);
+    treeNext_.assign(view.TreeNext(), view.TreeNext() + header.hierarchyTreeSize);
+    treeCost_.assign(view.TreeCosts(), view.TreeCosts() + header.hierarchyTreeSize);
+    edgeStart_.assign(view.EdgeStart(), view.EdgeStart() + triangleCount + 1);
+    edgeTarget_.assign(view.EdgeTargets(), view.EdgeTargets() + header.hierarchyEdgeCount);
+    edgeCost_.assign(view.EdgeCosts(), view.EdgeCosts() + header.hierarchyEdgeCount);
+}
+
+bool NavMeshHierarchy::Empty() const {
+    return cluster_.empty();
+}
+
+float NavMeshHierarchy::ClusterSize() const {
+    return clusterSize_;
+}
+
+int NavMeshHierarchy::ClusterCount() const {
+    return entranceStart_.empty() ? 0 : (int) entranceStart_.size() - 1;
+}
+
+int NavMeshHierarchy::Cluster(const int t) const {
+    return cluster_[t];
+}
+
+float NavMeshHierarchy::TreeCost(const int entrance, const int t) const {
+    return treeCost_[treeOffset_[entrance] + local_[t]];
+}
+
+int NavMeshHierarchy::TreeNext(const int entrance, const int t) const {
+    return treeNext_[treeOffset_[entrance] + local_[t]];
+}
+
+const int32_t *NavMeshHierarchy::EntrancesBegin(const int cluster) const {
+    return entrances_.data() + entranceStart_[cluster];
+}
+
+const int32_t *NavMeshHierarchy::EntrancesEnd(const int cluster) const {
+    return entrances_.data() + entranceStart_[cluster + 1];
+}
+
+int NavMeshHierarchy::EdgesBegin(const int entrance) const {
+    return edgeStart_[entrance];
+}
+
+int NavMeshHierarchy::EdgesEnd(const int entrance) const {
+    return edgeStart_[entrance + 1];
+}
+
+int NavMeshHierarchy::EdgeTarget(const int edge) const {
+    return edgeTarget_[edge];
+}
+
+float NavMeshHierarchy::EdgeCost(const int edge) const {
+    return edgeCost_[edge];
+}
+
+const vector<int32_t> &NavMeshHierarchy::Clusters() const {
+    return cluster_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::LocalIndices() const {
+    return local_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::EntranceStart() const {
+    return entranceStart_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::Entrances() const {
+    return entrances_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::TreeOffsets() const {
+    return treeOffset_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::TreeNext() const {
+    return treeNext_;
+}
+
+const vector<float> &NavMeshHierarchy::TreeCosts() const {
+    return treeCost_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::EdgeStart() const {
+    return edgeStart_;
+}
+
+const vector<int32_t> &NavMeshHierarchy::EdgeTargets() const {
+    return edgeTarget_;
+}
+
+const vector<float> &NavMeshHierarchy::EdgeCosts() const {
+    return edgeCost_;
+}
@@ -0,0 +1,112 @@
+#ifndef CPPOPTIMIZER_NAVMESHHIERARCHY_H
+#define CPPOPTIMIZER_NAVMESHHIERARCHY_H
+
+#include <cstdint>
+#include <vector>
+#include "NavMeshData.h"
+
+using namespace std;
+
+class NavMeshBinaryView;
+
+/// <summary>
+///     Cluster hierarchy over the triangle graph for HPA* style path queries.
+///     Triangles are grouped into clusters by the XZ grid cell their center lies in. Triangles with a link to a
+///     triangle of another cluster are the entrances, and they form the abstract graph: entrances are joined to
+///     the entrances they link to in other clusters, at the center distance, and to the other entrances of their
+///     own cluster, at the length of the shortest path inside the cluster. Every entrance stores the shortest path
+///     tree inside its cluster, rooted at itself, so a path found in the abstract graph is refined by following
+///     the trees, without searching again. The costs are the center distances the triangle A* uses, so a path
+///     through the abstract graph is as short as the one the triangle A* finds.
+///     All tables are flat arrays indexed by triangle id, as written to the binary file.
+///     Links are the neighbor slots with a portal, the hierarchy holds no reference to the mesh.
+/// </summary>
+class NavMeshHierarchy {
+private:
+    float clusterSize_ = 0;
+
+    /// <summary>
+    ///     Cluster of every triangle and its index within the cluster.
+    /// </summary>
+    vector<int32_t> cluster_, local_;
+
+    /// <summary>
+    ///     Entrances of cluster c are entrances[entranceStart[c]] up to entrances[entranceStart[c + 1]], ascending.
+    /// </summary>
+    vector<int32_t> entranceStart_, entrances_;
+
+    /// <summary>
+    ///     Per entrance the offset of its tree, -1 for other triangles. Entry treeOffset[e] + local[t] holds the
+    ///     next triangle from t toward e, -1 at e itself or when e can not be reached inside the cluster, and the
+    ///     cost from t to e.
+    /// </summary>
+    vector<int32_t> treeOffset_, treeNext_;
+    vector<float> treeCost_;
+
+    /// <summary>
+    ///     Abstract edges of entrance e are edgeTarget[edgeStart[e]] up to edgeTarget[edgeStart[e + 1]].
+    /// </summary>
+    vector<int32_t> edgeStart_, edgeTarget_;
+    vector<float> edgeCost_;
+
+public:
+    /// <summary>
+    ///     Builds the hierarchy for a mesh with neighbors and border widths set up. The cluster size starts at
+    ///     cellSize and is doubled until the clusters hold clusterTriangles triangles on average.
+    /// </summary>
+    void Build(const NavMeshData &mesh, float cellSize, int clusterTriangles);
+
+    /// <summary>
+    ///     Takes the hierarchy from the sections of a binary file, which must have them, without building it again.
+    /// </summary>
+    void Load(const NavMeshBinaryView &view);
+
+    bool Empty() const;
+
+    float ClusterSize() const;
+
+    int ClusterCount() const;
+
+    int Cluster(int t) const;
+
+    /// <returns>The cost from t to the entrance inside their cluster, infinity when it can not be reached.</returns>
+    float TreeCost(int entrance, int t) const;
+
+    /// <returns>The next triangle from t toward the entrance, -1 at the entrance.</returns>
+    int TreeNext(int entrance, int t) const;
+
+    const int32_t *EntrancesBegin(int cluster) const;
+
+    const int32_t *EntrancesEnd(int cluster) const;
+
+    int EdgesBegin(int entrance) const;
+
+    int EdgesEnd(int entrance) const;
+
+    int EdgeTarget(int edge) const;
+
+    float EdgeCost(int edge) const;
+
+    const vector<int32_t> &Clusters() const;
+
+    const vector<int32_t> &LocalIndices() const;
+
+    const vector<int32_t> &EntranceStart() const;
+
+    const vector<int32_t> &Entrances() const;
+
+    const vector<int32_t> &TreeOffsets() const;
+
+    const vector<int32_t> &TreeNext() const;
+
+    const vector<float> &TreeCosts() const;
+
+    const vector<int32_t> &EdgeStart() const;
+
+    const vector<int32_t> &EdgeTargets() const;
+
+    const vector<float> &EdgeCosts() const;
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHHIERARCHY_H
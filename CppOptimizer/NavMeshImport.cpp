@@ -3,12 +3,12 @@
 
 using namespace std;
 
-NavMeshImport::NavMeshImport( vector<float> &clean_point_in,  vector<Vector3> &vertices_in,
-                              vector<int> &indices_in, int finalVertexCount_in, int finalIndicesCount_in,
+NavMeshImport::NavMeshImport(vector<float> clean_point_in, vector<Vector3> vertices_in,
+                             vector<int> indices_in, int finalVertexCount_in, int finalIndicesCount_in,
                              int finalTriangleCount_in) {
-    cleanPoint = clean_point_in;
-    vertices = vertices_in;
-    indices = indices_in;
+    cleanPoint = std::move(clean_point_in);
+    vertices = std::move(vertices_in);
+    indices = std::move(indices_in);
 
     finalVertexCount = finalVertexCount_in;
     finalIndicesCount = finalIndicesCount_in;
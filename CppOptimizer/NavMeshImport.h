@@ -1,3 +1,6 @@
+#ifndef CPPOPTIMIZER_NAVMESHIMPORT_H
+#define CPPOPTIMIZER_NAVMESHIMPORT_H
+
 #include <vector>
 #include <list>
 #include "Vector3.h"
@@ -12,8 +15,8 @@ private:
     int finalVertexCount, finalTriangleCount, finalIndicesCount;
 
 public:
-    NavMeshImport(vector<float> &clean_point_in, vector<Vector3> &vertices_in,
-                  vector<int> &indices_in, int finalVertexCount_in, int finalIndicesCount_in,
+    NavMeshImport(vector<float> clean_point_in, vector<Vector3> vertices_in,
+                  vector<int> indices_in, int finalVertexCount_in, int finalIndicesCount_in,
                   int finalTriangleCount_in);
 
     vector<Vector3> &getVertices();
@@ -27,4 +30,7 @@ public:
     int FI();
 
     int FT();
-};
\ No newline at end of file
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHIMPORT_H
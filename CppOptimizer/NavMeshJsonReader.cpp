@@ -0,0 +1,201 @@
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "NavMeshJsonReader.h"
+#include "Profiler.h"
+
+using json = nlohmann::json;
+
+using namespace std;
+
+namespace {
+    /// <summary>
+    ///     SAX handler for the top level mesh object. Elements of the x, y, z and indices arrays are written to
+    ///     the output as they are parsed, every other value is skipped.
+    /// </summary>
+    struct NavMeshSax : nlohmann::json_sax<json> {
+        enum class Field {
+            None, CleanPoint, X, Y, Z, Indices, FinalVertexCount, FinalIndicesCount, FinalTriangleCount
+        };
+
+        vector<float> cleanPoint = vector<float>(3, 0.0f);
+        vector<Vector3> vertices = vector<Vector3>();
+        vector<int> indices = vector<int>();
+        int finalVertexCount = 0, finalIndicesCount = 0, finalTriangleCount = 0;
+        int xCount = 0, yCount = 0, zCount = 0;
+
+        std::string error;
+
+    private:
+        //Depth 1 is the top level object, depth 2 the arrays and the clean point object.
+        int depth_ = 0;
+        Field field_ = Field::None;
+        int cleanPointAxis_ = -1;
+
+        Vector3 &VertexAt(const int i) {
+            if (i >= (int) vertices.size())
+                vertices.resize(i + 1);
+            return vertices[i];
+        }
+
+        /// <param name="coordinate">The value as the json document converts it to float.</param>
+        /// <param name="number">The value used for the integer fields.</param>
+        bool Value(const float coordinate, const double number) {
+            if (depth_ == 1) {
+                if (field_ == Field::FinalVertexCount)
+                    finalVertexCount = (int) number;
+                else if (field_ == Field::FinalIndicesCount)
+                    finalIndicesCount = (int) number;
+                else if (field_ == Field::FinalTriangleCount)
+                    finalTriangleCount = (int) number;
+                return true;
+            }
+
+            if (depth_ != 2)
+                return true;
+
+            switch (field_) {
+                case Field::CleanPoint:
+                    if (cleanPointAxis_ != -1)
+                        cleanPoint[cleanPointAxis_] = coordinate;
+                    break;
+                case Field::X:
+                    VertexAt(xCount++).x = coordinate;
+                    break;
+                case Field::Y:
+                    VertexAt(yCount++).y = coordinate;
+                    break;
+                case Field::Z:
+                    VertexAt(zCount++).z = coordinate;
+                    break;
+                case Field::Indices:
+                    indices.push_back((int) number);
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        }
+
+    public:
+        bool null() override {
+            return true;
+        }
+
+        bool boolean(bool) override {
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) override {
+            return Value((float) value, (double) value);
+        }
+
+        bool number_unsigned(number_unsigned_t value) override {
+            return Value((float) value, (double) value);
+        }
+
+        bool number_float(number_float_t value, const string_t &) override {
+            return Value((float) value, value);
+        }
+
+        bool string(string_t &) override {
+            return true;
+        }
+
+        bool binary(binary_t &) override {
+            return true;
+        }
+
+        bool start_object(size_t) override {
+            depth_++;
+            return true;
+        }
+
+        bool key(string_t &key) override {
+            if (depth_ == 1) {
+                field_ = key == "cleanPoint" ? Field::CleanPoint
+                       : key == "x" ? Field::X
+                       : key == "y" ? Field::Y
+                       : key == "z" ? Field::Z
+                       : key == "indices" ? Field::Indices
+                       : key == "finalVertexCount" ? Field::FinalVertexCount
+                       : key == "finalIndicesCount" ? Field::FinalIndicesCount
+                       : key == "finalTriangleCount" ? Field::FinalTriangleCount
+                       : Field::None;
+            }
+            else if (depth_ == 2 && field_ == Field::CleanPoint) {
+                cleanPointAxis_ = key == "x" ? 0 : key == "y" ? 1 : key == "z" ? 2 : -1;
+            }
+            return true;
+        }
+
+        bool end_object() override {
+            depth_--;
+            return true;
+        }
+
+        bool start_array(size_t elements) override {
+            depth_++;
+            if (depth_ == 2 && field_ == Field::Indices && elements != (size_t) -1)
+                indices.reserve(elements);
+            return true;
+        }
+
+        bool end_array() override {
+            depth_--;
+            return true;
+        }
+
+        bool parse_error(size_t, const string_t &, const nlohmann::detail::exception &ex) override {
+            error = ex.what();
+            return false;
+        }
+
+    };
+}
+
+NavMeshImport NavMeshJsonReader::Load(const filesystem::path &file) {
+    PROFILE_SCOPE("Load");
+
+    ifstream str(file, ios::binary);
+    if (!str)
+        throw runtime_error("could not open " + file.string());
+
+    NavMeshSax sax = NavMeshSax();
+    if (!json::sax_parse(str, &sax))
+        throw runtime_error("could not parse " + file.string() + ": " + sax.error);
+
+    if (sax.xCount != sax.yCount || sax.xCount != sax.zCount)
+        throw runtime_error("x, y and z arrays differ in length in " + file.string());
+
+    return {std::move(sax.cleanPoint), std::move(sax.vertices), std::move(sax.indices),
+            sax.finalVertexCount, sax.finalIndicesCount, sax.finalTriangleCount};
+}
+
+NavMeshImport NavMeshJsonReader::LoadDom(const filesystem::path &file) {
+    ifstream str(file);
+    if (!str)
+        throw runtime_error("could not open " + file.string());
+    json js = json::parse(str);
+
+    vector<float> cleanPoint = vector<float>{(float) js["cleanPoint"]["x"],
+                                             (float) js["cleanPoint"]["y"],
+                                             (float) js["cleanPoint"]["z"]};
+
+    vector<Vector3> vertexPoints = vector<Vector3>();
+
+    for (int i = 0; i < (int) js["x"].size(); ++i) {
+        vertexPoints.emplace_back((float) js["x"][i], (float) js["y"][i], (float) js["z"][i]);
+    }
+
+    vector<int> indices = vector<int>();
+
+    for (const auto &item: js["indices"])
+        indices.push_back((int) item);
+
+    return {cleanPoint, vertexPoints, indices,
+            (int) js["finalVertexCount"],
+            (int) js["finalIndicesCount"],
+            (int) js["finalTriangleCount"]};
+}
@@ -0,0 +1,24 @@
+#ifndef CPPOPTIMIZER_NAVMESHJSONREADER_H
+#define CPPOPTIMIZER_NAVMESHJSONREADER_H
+
+#include <filesystem>
+#include "NavMeshImport.h"
+
+using namespace std;
+
+/// <summary>
+///     Reads the navigation mesh json files exported from Unity.
+///     Load streams the file through a SAX handler that writes every number straight into the NavMeshImport
+///     arrays, so no json document is built. LoadDom is the original loader parsing the whole file into a json
+///     document first, kept for comparison.
+///     Both throw runtime_error when the file can not be opened or does not hold a valid mesh.
+/// </summary>
+class NavMeshJsonReader {
+public:
+    static NavMeshImport Load(const filesystem::path &file);
+
+    static NavMeshImport LoadDom(const filesystem::path &file);
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHJSONREADER_H
@@ -1,57 +1,135 @@
 #include <cmath>
+#include <stdexcept>
+#include <utility>
 #include "NavMeshOptimized.h"
+#include "GeometryPolicy.h"
+#include "NavMeshBinary.h"
+#include "Profiler.h"
 
 using namespace std;
 
 vector<vector<float>> NavMeshOptimized::getVertices() {
-    vector<vector<float>> result =  vector<vector<float>>();
+    vector<vector<float>> result = vector<vector<float>>();
+    result.reserve(mesh_.VertexCount());
 
-    for (int i = 0; i < vertices2D.size(); ++i) {
-        Vector2 v = vertices2D.at(i);
-        result.push_back(*new vector<float>{v.x, verticesY[i], v.y});
-    }
+    for (int i = 0; i < mesh_.VertexCount(); ++i)
+        result.push_back(vector<float>{mesh_.x[i], mesh_.y[i], mesh_.z[i]});
 
     return result;
 }
 
 vector<NavMeshTriangle> &NavMeshOptimized::getTriangles() {
-    return triangles_;
+    return mesh_.triangles;
 }
 
-void
-NavMeshOptimized::SetValues(vector<Vector3> &vertices_in, vector<int> &indices_in, vector<NavMeshTriangle> &triangles_in, const float groupDivision) {
-    vertices2D =  vector<Vector2>();
-    verticesY =  vector<float>();
-    indices = indices_in;
+NavMeshData &NavMeshOptimized::getMesh() {
+    return mesh_;
+}
 
-    for (Vector3 &vertex: vertices_in) {
-        vertices2D.push_back( Vector2{vertex.x, vertex.z});
-        verticesY.push_back(vertex.y);
-    }
+void NavMeshOptimized::SetValues(NavMeshData &mesh_in, const float groupDivision) {
+    PROFILE_SCOPE("SetValues");
 
-    triangles_ = triangles_in;
+    mesh_ = std::move(mesh_in);
+    mesh_in.Clear();
 
-    trianglesByVertexPosition = *new map<Vector2Int, vector<int>>;
+    triangleLocator.Build(mesh_, groupDivision);
+    hierarchy.Build(mesh_, groupDivision, DefaultPolicy::clusterTriangles);
+}
 
-    triangleByVertexId = *new map<int, vector<int>>;
+void NavMeshOptimized::PatchValues(NavMeshData &mesh_in, const float groupDivision, const vector<int> &triangleRemap,
+                                   const int firstNewTriangle) {
+    PROFILE_SCOPE("PatchValues");
 
-    for (int i = 0; i < verticesY.size(); ++i) {
-        triangleByVertexId.insert({i,  vector<int>()});
-    }
+    mesh_ = std::move(mesh_in);
+    mesh_in.Clear();
+
+    triangleLocator.Update(mesh_, groupDivision, triangleRemap, firstNewTriangle);
+    hierarchy.Build(mesh_, groupDivision, DefaultPolicy::clusterTriangles);
+}
 
-    for (NavMeshTriangle &t: triangles_) {
-        for (int &vertexIndex: t.vertices()) {
-            Vector2Int vertexID = {(int) floor(vertices2D[vertexIndex].x / groupDivision),
-                                   (int) floor(vertices2D[vertexIndex].y / groupDivision)};
+void NavMeshOptimized::Load(const NavMeshBinaryView &view) {
+    PROFILE_SCOPE("LoadBinary");
 
-            if (trianglesByVertexPosition.find(vertexID) == trianglesByVertexPosition.end())
-                trianglesByVertexPosition.insert({vertexID,  vector<int>()});
+    if (view.Neighbors() == nullptr)
+        throw runtime_error("binary navigation mesh has no neighbor table, it was not written by the optimizer");
 
-            trianglesByVertexPosition[vertexID].push_back(t.id());
+    const int vertexCount = view.VertexCount(), triangleCount = view.TriangleCount();
+    mesh_.Clear();
+    mesh_.x.assign(view.X(), view.X() + vertexCount);
+    mesh_.y.assign(view.Y(), view.Y() + vertexCount);
+    mesh_.z.assign(view.Z(), view.Z() + vertexCount);
+    mesh_.indices.assign(view.Indices(), view.Indices() + view.IndexCount());
+
+    //Links are set in their written slot order, so every slot gets the same portal as in the baked mesh.
+    const int32_t *neighbors = view.Neighbors();
+    vector<int> links = vector<int>();
+    mesh_.triangles.reserve(triangleCount);
+    for (int t = 0; t < triangleCount; t++) {
+        NavMeshTriangle triangle = NavMeshTriangle(t, mesh_.indices[t * 3], mesh_.indices[t * 3 + 1],
+                                                   mesh_.indices[t * 3 + 2]);
+        links.clear();
+        for (int k = 0; k < 3; k++) {
+            if (neighbors[t * 3 + k] != -1)
+                links.push_back(neighbors[t * 3 + k]);
         }
+        triangle.SetNeighborIds(links);
+        mesh_.triangles.push_back(triangle);
     }
+    for (NavMeshTriangle &triangle: mesh_.triangles)
+        triangle.SetBorderWidth(mesh_);
+
+    nonManifoldEdges.clear();
+    islandSizes.clear();
+    keptIslands.clear();
+
+    //The optimizer bakes with the group size as group division.
+    if (view.BucketStart() != nullptr)
+        triangleLocator.Load(view);
+    else
+        triangleLocator.Build(mesh_, DefaultPolicy::groupSize);
+    if (view.Clusters() != nullptr)
+        hierarchy.Load(view);
+    else
+        hierarchy.Build(mesh_, DefaultPolicy::groupSize, DefaultPolicy::clusterTriangles);
 }
 
 vector<int> &NavMeshOptimized::getIndices() {
-    return indices;
+    return mesh_.indices;
+}
+
+vector<Vector2Int> &NavMeshOptimized::getNonManifoldEdges() {
+    return nonManifoldEdges;
+}
+
+void NavMeshOptimized::SetNonManifoldEdges(const vector<Vector2Int> &edges) {
+    nonManifoldEdges = edges;
+}
+
+vector<int> &NavMeshOptimized::getIslandSizes() {
+    return islandSizes;
+}
+
+vector<int> &NavMeshOptimized::getKeptIslands() {
+    return keptIslands;
+}
+
+void NavMeshOptimized::SetIslands(const vector<int> &sizes, const vector<int> &kept) {
+    islandSizes = sizes;
+    keptIslands = kept;
+}
+
+const TriangleLocator &NavMeshOptimized::getTriangleLocator() const {
+    return triangleLocator;
+}
+
+const NavMeshHierarchy &NavMeshOptimized::getHierarchy() const {
+    return hierarchy;
+}
+
+int NavMeshOptimized::FindTriangle(const float x, const float z) const {
+    return triangleLocator.FindTriangle(mesh_, x, z);
+}
+
+bool NavMeshOptimized::ClosestPointOnMesh(const Vector3 &point, Vector3 &closest, int &triangle) const {
+    return triangleLocator.ClosestPointOnMesh(mesh_, point, closest, triangle);
 }
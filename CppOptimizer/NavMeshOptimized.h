@@ -1,25 +1,41 @@
+#ifndef CPPOPTIMIZER_NAVMESHOPTIMIZED_H
+#define CPPOPTIMIZER_NAVMESHOPTIMIZED_H
+
 #include <vector>
-#include <map>
+#include "NavMeshData.h"
+#include "NavMeshHierarchy.h"
 #include "NavMeshTriangle.h"
+#include "TriangleLocator.h"
 #include "Vector3.h"
 #include "Vector2Int.h"
 
 using namespace std;
 
+class NavMeshBinaryView;
+
 struct NavMeshOptimized {
 private:
-    vector<Vector2> vertices2D;
-    vector<float> verticesY;
-    vector<int> indices;
+    NavMeshData mesh_;
+
+    /// <summary>
+    ///     Triangles by every grid cell they overlap, built with the group division as cell size.
+    /// </summary>
+    TriangleLocator triangleLocator;
 
-    vector<NavMeshTriangle> triangles_;
+    /// <summary>
+    ///     Cluster hierarchy over the triangle graph for long path queries, clusters start at the group division.
+    /// </summary>
+    NavMeshHierarchy hierarchy;
 
-    map<Vector2Int, vector<int>> trianglesByVertexPosition;
+    /// <summary>
+    ///     Edges shared by more than two triangles, stored as (lowest vertex id, highest vertex id).
+    /// </summary>
+    vector<Vector2Int> nonManifoldEdges;
 
     /// <summary>
-    ///     Index of vertex returns all NavTriangles containing the vertex id.
+    ///     Triangle count of every connected island in the welded input mesh, and the ids of the islands kept.
     /// </summary>
-    map<int, vector<int>> triangleByVertexId;
+    vector<int> islandSizes, keptIslands;
 
 public:
     vector<vector<float>> getVertices();
@@ -28,7 +44,51 @@ public:
 
     vector<NavMeshTriangle> &getTriangles();
 
-    void
-    SetValues(vector<Vector3> &vertices_in, vector<int> &indices_in, vector<NavMeshTriangle> &triangles_in,
-              float groupDivision);
-};
\ No newline at end of file
+    NavMeshData &getMesh();
+
+    vector<Vector2Int> &getNonManifoldEdges();
+
+    void SetNonManifoldEdges(const vector<Vector2Int> &edges);
+
+    vector<int> &getIslandSizes();
+
+    vector<int> &getKeptIslands();
+
+    void SetIslands(const vector<int> &sizes, const vector<int> &kept);
+
+    const TriangleLocator &getTriangleLocator() const;
+
+    const NavMeshHierarchy &getHierarchy() const;
+
+    /// <returns>The lowest id of the triangles containing the point in the XZ plane, or -1.</returns>
+    int FindTriangle(float x, float z) const;
+
+    /// <summary>
+    ///     Closest point on the surface of the mesh and the triangle it lies on.
+    /// </summary>
+    /// <returns>False when the mesh is empty.</returns>
+    bool ClosestPointOnMesh(const Vector3 &point, Vector3 &closest, int &triangle) const;
+
+    /// <summary>
+    ///     Takes ownership of the mesh data, the caller's mesh is left empty. Expects the neighbors and border widths
+    ///     to be set up for the hierarchy.
+    /// </summary>
+    void SetValues(NavMeshData &mesh_in, float groupDivision);
+
+    /// <summary>
+    ///     Takes ownership of a mesh patched from the current one and updates the lookups without rebuilding them.
+    ///     The kept triangles keep their relative order, see TriangleLocator::Update. The hierarchy is built again.
+    /// </summary>
+    void PatchValues(NavMeshData &mesh_in, float groupDivision, const vector<int> &triangleRemap,
+                     int firstNewTriangle);
+
+    /// <summary>
+    ///     Takes a mesh baked by the optimizer from a binary file, without running the pipeline again. The triangles
+    ///     are linked from the neighbor table and the locator is taken from the spatial buckets when the file has
+    ///     them, as is the hierarchy. Throws runtime_error when the file has no neighbor table.
+    /// </summary>
+    void Load(const NavMeshBinaryView &view);
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHOPTIMIZED_H
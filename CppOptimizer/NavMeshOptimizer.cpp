@@ -0,0 +1,725 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <set>
+#include "NavMeshOptimizer.h"
+#include "EdgeAdjacency.h"
+#include "GeometryPolicy.h"
+#include "HoleFiller.h"
+#include "MathC.h"
+#include "MeshDecimator.h"
+#include "MeshConnectivity.h"
+#include "Profiler.h"
+#include "UniformGrid.h"
+#include "VertexWeld.h"
+
+using namespace std;
+
+static constexpr float groupSize = DefaultPolicy::groupSize;
+static constexpr float overlapCheckDistance = DefaultPolicy::overlapCheckDistance;
+static constexpr float decimationError = DefaultPolicy::decimationError;
+
+/// <summary>
+///     First iteration of NavTriangles over the welded mesh.
+/// </summary>
+static void LinkWeldedMesh(NavMeshData &mesh, pmr::map<int, pmr::vector<int>> &trianglesByVertexId) {
+    for (int i = 0; i < mesh.VertexCount(); i++)
+        trianglesByVertexId.insert({i, pmr::vector<int>()});
+
+    SetupNavTriangles(mesh, trianglesByVertexId);
+
+    EdgeAdjacency adjacency = EdgeAdjacency();
+    adjacency.Build(mesh.indices, mesh.VertexCount());
+    adjacency.SetupNeighbors(mesh.triangles);
+}
+
+vector<int> KeepConnected(const Vector3 &cleanPoint, const NavMeshData &mesh,
+                          pmr::map<int, pmr::vector<int>> &trianglesByVertexId, const int minIslandTriangles,
+                          vector<int> &islandSizes, vector<int> &keptIslands) {
+    PROFILE_SCOPE("FloodFill");
+
+#pragma region Check neighbor connections
+
+    const vector<NavMeshTriangle> &triangles = mesh.triangles;
+
+    int closestVert = 0;
+    float closestDistance = Vector3::Distance(cleanPoint, mesh.Vertex(closestVert));
+
+    for (int i = 1; i < mesh.VertexCount(); i++) {
+        const float d = Vector3::Distance(cleanPoint, mesh.Vertex(i));
+
+        if (d >= closestDistance)
+            continue;
+
+        if (trianglesByVertexId.find(i) != trianglesByVertexId.end()) {
+            bool found = false;
+            for (const int &t: trianglesByVertexId[i])
+                if (triangles[t].neighborCount() > 0) {
+                    found = true;
+                    break;
+                }
+
+            if (!found)
+                continue;
+        }
+
+        closestDistance = d;
+        closestVert = i;
+    }
+
+    vector<int> islandLabels = vector<int>();
+    MeshConnectivity connectivity = MeshConnectivity();
+    connectivity.LabelComponents(triangles, islandLabels, islandSizes);
+
+    vector<int> connected = vector<int>();
+    keptIslands.clear();
+    connected.reserve(triangles.size());
+    connectivity.Reset((int) triangles.size());
+    const pmr::vector<int> &seeds = trianglesByVertexId[closestVert];
+    connectivity.FloodFill(triangles, seeds.data(), (int) seeds.size(), connected);
+    if (!connected.empty())
+        keptIslands.push_back(islandLabels[connected[0]]);
+
+    if (minIslandTriangles > 0) {
+        //The first triangle of every island, islands are numbered by their lowest triangle id.
+        for (int t = 0; t < (int) triangles.size(); t++) {
+            if (connectivity.Visited(t) || islandSizes[islandLabels[t]] < minIslandTriangles)
+                continue;
+
+            keptIslands.push_back(islandLabels[t]);
+            connectivity.FloodFill(triangles, &t, 1, connected);
+        }
+    }
+
+    PROFILE_COUNT("Flood fill size", connected.size());
+    PROFILE_COUNT("Triangles dropped by flood fill", triangles.size() - connected.size());
+
+#pragma endregion
+
+    return connected;
+}
+
+/// <summary>
+///     Final iteration of NavTriangles over the filled mesh, which is moved into the result.
+/// </summary>
+static NavMeshOptimized LinkFinalMesh(NavMeshData &fixedMesh, const vector<int> &islandSizes,
+                                      const vector<int> &keptIslands,
+                                      pmr::memory_resource *memory = pmr::get_default_resource()) {
+    pmr::map<int, pmr::vector<int>> fixedTrianglesByVertexId = pmr::map<int, pmr::vector<int>>(memory);
+    for (int i = 0; i < fixedMesh.VertexCount(); i++)
+        fixedTrianglesByVertexId.insert({i, pmr::vector<int>()});
+
+    SetupNavTriangles(fixedMesh, fixedTrianglesByVertexId);
+
+    EdgeAdjacency adjacency = EdgeAdjacency();
+    adjacency.Build(fixedMesh.indices, fixedMesh.VertexCount());
+    adjacency.SetupNeighbors(fixedMesh.triangles);
+
+    for (NavMeshTriangle &triangle: fixedMesh.triangles)
+        triangle.SetBorderWidth(fixedMesh);
+
+    NavMeshOptimized result = NavMeshOptimized();
+    result.SetValues(fixedMesh, groupSize);
+    result.SetNonManifoldEdges(adjacency.NonManifoldEdges());
+    result.SetIslands(islandSizes, keptIslands);
+    return result;
+}
+
+/// <summary>
+///     Closes the holes of the mesh with the chosen HoleFiller mode.
+/// </summary>
+static void FillHoles(NavMeshData &mesh, const HoleFillMode holeFillMode, ThreadPool *pool,
+                      pmr::memory_resource *memory = pmr::get_default_resource()) {
+    if (holeFillMode == HoleFillMode::BoundaryLoops)
+        HoleFiller::FillHoleLoops(mesh, overlapCheckDistance, 0, memory);
+    else
+        HoleFiller::FillHoles(mesh, groupSize, pool, 0, memory);
+}
+
+NavMeshOptimized OptimizeNavMesh(const Vector3 cleanPoint, NavMeshData &mesh, ThreadPool *pool,
+                                 const int minIslandTriangles, pmr::memory_resource *arena,
+                                 const HoleFillMode holeFillMode, const bool decimate) {
+    PROFILE_SCOPE("OptimizeNavMesh");
+
+    //Without an arena the temporaries still come from a local bump allocator, freed at once when the run ends.
+    pmr::monotonic_buffer_resource local = pmr::monotonic_buffer_resource();
+    pmr::memory_resource *memory = arena == nullptr ? &local : arena;
+
+#pragma region Check Vertices and Indices for overlap
+
+    VertexWeld::Weld(mesh, overlapCheckDistance);
+
+#pragma endregion
+
+#pragma region Create first iteration of NavTriangles
+
+    pmr::map<int, pmr::vector<int>> trianglesByVertexId = pmr::map<int, pmr::vector<int>>(memory);
+    LinkWeldedMesh(mesh, trianglesByVertexId);
+
+#pragma endregion
+
+    vector<int> islandSizes = vector<int>(), keptIslands = vector<int>();
+    const vector<int> connected = KeepConnected(cleanPoint, mesh, trianglesByVertexId, minIslandTriangles,
+                                                islandSizes, keptIslands);
+
+#pragma region Fill holes and final iteration of NavTriangles
+
+    NavMeshData fixedMesh = mesh.Extract(connected, memory);
+
+    FillHoles(fixedMesh, holeFillMode, pool, memory);
+
+    if (decimate)
+        MeshDecimator::Decimate(fixedMesh, decimationError, memory);
+
+#pragma endregion
+
+    return LinkFinalMesh(fixedMesh, islandSizes, keptIslands, memory);
+}
+
+/// <summary>
+///     Triangles grouped by the XZ tile their center lies in, tiles in order of their first triangle.
+/// </summary>
+static void SplitTiles(const NavMeshData &mesh, const float tileSize, vector<vector<int>> &tiles,
+                       vector<Vector2Int> &tileCells) {
+    map<Vector2Int, int> tileByCell = map<Vector2Int, int>();
+    tiles.clear();
+    tileCells.clear();
+
+    for (int t = 0; t < mesh.TriangleCount(); t++) {
+        const int a = mesh.indices[t * 3], b = mesh.indices[t * 3 + 1], c = mesh.indices[t * 3 + 2];
+        const Vector2Int cell = Vector2Int((int) floor((mesh.x[a] + mesh.x[b] + mesh.x[c]) / 3.0f / tileSize),
+                                           (int) floor((mesh.z[a] + mesh.z[b] + mesh.z[c]) / 3.0f / tileSize));
+
+        auto inserted = tileByCell.insert({cell, (int) tiles.size()});
+        if (inserted.second) {
+            tiles.emplace_back();
+            tileCells.push_back(cell);
+        }
+        tiles[inserted.first->second].push_back(t);
+    }
+}
+
+/// <summary>
+///     Copies the triangles into a compact tile mesh and records the mesh vertex of every tile vertex. The remap is
+///     scratch of the mesh vertex count filled with -1, and is left that way.
+/// </summary>
+static void ExtractTile(const NavMeshData &mesh, const vector<int> &triangleIds, vector<int> &remap,
+                        NavMeshData &tile, vector<int> &tileToMesh) {
+    tile.Clear();
+    tileToMesh.clear();
+    if ((int) remap.size() != mesh.VertexCount())
+        remap.assign(mesh.VertexCount(), -1);
+
+    for (const int t: triangleIds) {
+        for (int k = 0; k < 3; k++) {
+            const int v = mesh.indices[t * 3 + k];
+            if (remap[v] == -1) {
+                remap[v] = tile.AddVertex(mesh.Vertex(v));
+                tileToMesh.push_back(v);
+            }
+            tile.indices.push_back(remap[v]);
+        }
+    }
+
+    for (const int v: tileToMesh)
+        remap[v] = -1;
+}
+
+/// <summary>
+///     Welds vertices of different tiles that lie within the weld distance of each other. Of every such pair at
+///     least one vertex lies near or outside the border of its own tile, so only those vertices search for
+///     partners. Collapsed triangles are dropped.
+/// </summary>
+static void WeldSeams(NavMeshData &mesh, const vector<int> &vertexTile, const vector<Vector2Int> &tileCells,
+                      const float tileSize, const float weldDistance) {
+    PROFILE_SCOPE("WeldSeams");
+
+    vector<int> border = vector<int>();
+    for (int v = 0; v < mesh.VertexCount(); v++) {
+        const Vector2Int &cell = tileCells[vertexTile[v]];
+        const float minX = (float) cell.x * tileSize, minZ = (float) cell.y * tileSize;
+
+        if (mesh.x[v] - minX <= weldDistance || minX + tileSize - mesh.x[v] <= weldDistance ||
+            mesh.z[v] - minZ <= weldDistance || minZ + tileSize - mesh.z[v] <= weldDistance)
+            border.push_back(v);
+    }
+
+    vector<int> parent = vector<int>(mesh.VertexCount());
+    for (int v = 0; v < mesh.VertexCount(); v++)
+        parent[v] = v;
+
+    if (!border.empty()) {
+        float minX = mesh.x[0], minZ = mesh.z[0], maxX = minX, maxZ = minZ;
+        for (int v = 1; v < mesh.VertexCount(); v++) {
+            minX = MathC::Min(minX, mesh.x[v]);
+            minZ = MathC::Min(minZ, mesh.z[v]);
+            maxX = MathC::Max(maxX, mesh.x[v]);
+            maxZ = MathC::Max(maxZ, mesh.z[v]);
+        }
+
+        UniformGrid grid = UniformGrid();
+        grid.Reset(minX, minZ, maxX, maxZ, weldDistance * 2.0f, mesh.VertexCount());
+        for (int v = 0; v < mesh.VertexCount(); v++)
+            grid.Insert(v, mesh.x[v], mesh.z[v]);
+
+        //As in VertexWeld, in vertex order every searching vertex still alive absorbs the others within reach.
+        const float searchRadius = weldDistance * 1.5f;
+        for (const int current: border) {
+            if (parent[current] != current)
+                continue;
+
+            const float cx = mesh.x[current], cy = mesh.y[current], cz = mesh.z[current];
+            Vector2Int from = grid.CellOf(cx - searchRadius, cz - searchRadius),
+                    to = grid.CellOf(cx + searchRadius, cz + searchRadius);
+
+            for (int z = from.y; z <= to.y; z++) {
+                for (int x = from.x; x <= to.x; x++) {
+                    for (int e = grid.Head(x, z); e != -1; e = grid.Next(e)) {
+                        const int other = grid.Item(e);
+                        if (vertexTile[other] == vertexTile[current] || parent[other] != other)
+                            continue;
+
+                        const float dx = cx - mesh.x[other], dy = cy - mesh.y[other], dz = cz - mesh.z[other];
+                        if (sqrt(dx * dx + dy * dy + dz * dz) <= weldDistance)
+                            parent[other] = current;
+                    }
+                }
+            }
+        }
+    }
+
+    //A vertex that absorbed others can still be absorbed by a later one.
+    for (int v = 0; v < mesh.VertexCount(); v++) {
+        int root = parent[v];
+        while (parent[root] != root)
+            root = parent[root];
+        parent[v] = root;
+    }
+
+    vector<int> &indices = mesh.indices;
+    int write = 0;
+    for (int i = 0; i < (int) indices.size(); i += 3) {
+        const int a = parent[indices[i]], b = parent[indices[i + 1]], c = parent[indices[i + 2]];
+        if (a == b || a == c || b == c)
+            continue;
+
+        indices[write] = a;
+        indices[write + 1] = b;
+        indices[write + 2] = c;
+        write += 3;
+    }
+    indices.resize(write);
+}
+
+NavMeshOptimized OptimizeNavMeshTiled(const Vector3 cleanPoint, const NavMeshData &mesh, const float tileSize,
+                                      ThreadPool *pool, const int minIslandTriangles,
+                                      const HoleFillMode holeFillMode, const bool decimate) {
+    PROFILE_SCOPE("OptimizeNavMeshTiled");
+
+    vector<vector<int>> tiles = vector<vector<int>>();
+    vector<Vector2Int> tileCells = vector<Vector2Int>();
+    const int workerCount = pool == nullptr ? 1 : pool->ThreadCount();
+    vector<vector<int>> remaps = vector<vector<int>>(workerCount);
+
+#pragma region Weld every tile and the seams between them
+
+    SplitTiles(mesh, tileSize, tiles, tileCells);
+
+    vector<NavMeshData> tileMeshes = vector<NavMeshData>(tiles.size());
+    vector<vector<int>> tileToMesh = vector<vector<int>>(tiles.size());
+    ThreadPool::ParallelFor(pool, (int) tiles.size(), 1, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; i++) {
+            ExtractTile(mesh, tiles[i], remaps[worker], tileMeshes[i], tileToMesh[i]);
+            VertexWeld::Weld(tileMeshes[i], overlapCheckDistance);
+        }
+    });
+
+    NavMeshData welded = NavMeshData();
+    vector<int> vertexTile = vector<int>();
+    for (int i = 0; i < (int) tiles.size(); i++) {
+        const NavMeshData &tile = tileMeshes[i];
+        const int offset = welded.VertexCount();
+
+        welded.x.insert(welded.x.end(), tile.x.begin(), tile.x.end());
+        welded.y.insert(welded.y.end(), tile.y.begin(), tile.y.end());
+        welded.z.insert(welded.z.end(), tile.z.begin(), tile.z.end());
+        vertexTile.insert(vertexTile.end(), tile.VertexCount(), i);
+        for (const int index: tile.indices)
+            welded.indices.push_back(index + offset);
+    }
+
+    WeldSeams(welded, vertexTile, tileCells, tileSize, overlapCheckDistance);
+
+    vector<int> all = vector<int>(welded.TriangleCount());
+    for (int t = 0; t < welded.TriangleCount(); t++)
+        all[t] = t;
+    welded = welded.Extract(all);
+
+#pragma endregion
+
+    pmr::map<int, pmr::vector<int>> trianglesByVertexId = pmr::map<int, pmr::vector<int>>();
+    LinkWeldedMesh(welded, trianglesByVertexId);
+
+    vector<int> islandSizes = vector<int>(), keptIslands = vector<int>();
+    const vector<int> connected = KeepConnected(cleanPoint, welded, trianglesByVertexId, minIslandTriangles,
+                                                islandSizes, keptIslands);
+
+#pragma region Fill holes per tile and stitch them together
+
+    NavMeshData fixedMesh = welded.Extract(connected);
+
+    SplitTiles(fixedMesh, tileSize, tiles, tileCells);
+    tileMeshes.assign(tiles.size(), NavMeshData());
+    tileToMesh.assign(tiles.size(), vector<int>());
+    ThreadPool::ParallelFor(pool, (int) tiles.size(), 1, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; i++) {
+            ExtractTile(fixedMesh, tiles[i], remaps[worker], tileMeshes[i], tileToMesh[i]);
+            FillHoles(tileMeshes[i], holeFillMode, nullptr);
+        }
+    });
+
+    //Tiles are merged in order, so the result does not depend on the thread count. A vertex pushed in several
+    //tiles takes the position of the first, and a triangle added by several tiles is added once.
+    vector<uint8_t> moved = vector<uint8_t>(fixedMesh.VertexCount(), 0);
+    set<array<int, 3>> addedKeys = set<array<int, 3>>();
+
+    vector<int> triangleTile = vector<int>(fixedMesh.TriangleCount());
+    for (int i = 0; i < (int) tiles.size(); i++) {
+        for (const int t: tiles[i])
+            triangleTile[t] = i;
+    }
+
+    for (int i = 0; i < (int) tiles.size(); i++) {
+        const NavMeshData &tile = tileMeshes[i];
+        const vector<int> &toMesh = tileToMesh[i];
+
+        for (int v = 0; v < tile.VertexCount(); v++) {
+            const int target = toMesh[v];
+            if (moved[target] || tile.Vertex(v) == fixedMesh.Vertex(target))
+                continue;
+
+            moved[target] = 1;
+            fixedMesh.SetVertex(target, tile.Vertex(v));
+        }
+
+        for (int k = (int) tiles[i].size() * 3; k < (int) tile.indices.size(); k += 3) {
+            array<int, 3> key = {toMesh[tile.indices[k]], toMesh[tile.indices[k + 1]], toMesh[tile.indices[k + 2]]};
+            array<int, 3> sorted = key;
+            sort(sorted.begin(), sorted.end());
+
+            if (!addedKeys.insert(sorted).second)
+                continue;
+
+            fixedMesh.indices.insert(fixedMesh.indices.end(), key.begin(), key.end());
+            triangleTile.push_back(i);
+        }
+    }
+
+    //Holes spanning a tile border were open in every tile they touch, and are closed on the merged mesh.
+    HoleFiller::FillHoleLoops(fixedMesh, overlapCheckDistance, 0, pmr::get_default_resource(), &triangleTile);
+
+    //Runs on the merged mesh, so the seams decimate like any other edge.
+    if (decimate)
+        MeshDecimator::Decimate(fixedMesh, decimationError);
+
+#pragma endregion
+
+    return LinkFinalMesh(fixedMesh, islandSizes, keptIslands);
+}
+
+void ReoptimizeNavMesh(NavMeshOptimized &optimized, const Vector3 &dirtyMin, const Vector3 &dirtyMax,
+                       const NavMeshData &replacement, ThreadPool *pool) {
+    PROFILE_SCOPE("ReoptimizeNavMesh");
+
+    NavMeshData &mesh = optimized.getMesh();
+    const TriangleLocator &locator = optimized.getTriangleLocator();
+    const vector<int> &indices = mesh.indices;
+
+#pragma region Remove the triangles in the dirty box
+
+    vector<int> found = vector<int>();
+    locator.FindTriangles(mesh, dirtyMin.x, dirtyMin.z, dirtyMax.x, dirtyMax.z, found);
+
+    vector<uint8_t> removed = vector<uint8_t>(mesh.TriangleCount(), 0);
+    for (const int t: found) {
+        const int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+
+        if (dirtyMax.y < MathC::Min(MathC::Min(mesh.y[a], mesh.y[b]), mesh.y[c]) ||
+            dirtyMin.y > MathC::Max(MathC::Max(mesh.y[a], mesh.y[b]), mesh.y[c]))
+            continue;
+
+        removed[t] = 1;
+    }
+
+#pragma endregion
+
+#pragma region Weld and fill the region
+
+    //The remaining triangles within a group cell of the edit are copied first, with their vertices fixed, so the
+    //replacement welds onto them and the hole filler tests its new triangles against them.
+    float minX = dirtyMin.x, minZ = dirtyMin.z, maxX = dirtyMax.x, maxZ = dirtyMax.z;
+    for (int i = 0; i < replacement.VertexCount(); i++) {
+        minX = MathC::Min(minX, replacement.x[i]);
+        minZ = MathC::Min(minZ, replacement.z[i]);
+        maxX = MathC::Max(maxX, replacement.x[i]);
+        maxZ = MathC::Max(maxZ, replacement.z[i]);
+    }
+
+    vector<int> context = vector<int>();
+    locator.FindTriangles(mesh, minX - groupSize, minZ - groupSize, maxX + groupSize, maxZ + groupSize, context);
+    context.erase(remove_if(context.begin(), context.end(), [&removed](int t) { return removed[t] != 0; }),
+                  context.end());
+
+    NavMeshData local = NavMeshData();
+    vector<int> localToGlobal = vector<int>(), globalToLocal = vector<int>(mesh.VertexCount(), -1);
+    vector<array<int, 3>> contextKeys = vector<array<int, 3>>();
+    contextKeys.reserve(context.size());
+
+    for (const int t: context) {
+        array<int, 3> key = array<int, 3>();
+        for (int k = 0; k < 3; k++) {
+            const int v = indices[t * 3 + k];
+            if (globalToLocal[v] == -1) {
+                globalToLocal[v] = local.AddVertex(mesh.Vertex(v));
+                localToGlobal.push_back(v);
+            }
+
+            key[k] = globalToLocal[v];
+            local.indices.push_back(key[k]);
+        }
+
+        sort(key.begin(), key.end());
+        contextKeys.push_back(key);
+    }
+    sort(contextKeys.begin(), contextKeys.end());
+
+    const int fixedCount = local.VertexCount(), contextIndexCount = (int) local.indices.size();
+
+    for (int i = 0; i < replacement.VertexCount(); i++)
+        local.AddVertex(replacement.Vertex(i));
+
+    for (int i = 0; i + 2 < (int) replacement.indices.size(); i += 3) {
+        const int a = replacement.indices[i], b = replacement.indices[i + 1], c = replacement.indices[i + 2];
+        if (min(min(a, b), c) < 0 || max(max(a, b), c) >= replacement.VertexCount())
+            continue;
+
+        local.indices.insert(local.indices.end(), {fixedCount + a, fixedCount + b, fixedCount + c});
+    }
+
+    VertexWeld::Weld(local, overlapCheckDistance, fixedCount);
+    HoleFiller::FillHoles(local, groupSize, pool, fixedCount);
+
+#pragma endregion
+
+#pragma region Merge the region back
+
+    //Welding leaves the context triangles in front, everything behind them is new. Replacement triangles that
+    //welded onto an existing triangle are dropped.
+    vector<int> added = vector<int>();
+    for (int i = contextIndexCount; i < (int) local.indices.size(); i += 3) {
+        array<int, 3> key = {local.indices[i], local.indices[i + 1], local.indices[i + 2]};
+        sort(key.begin(), key.end());
+
+        if (!binary_search(contextKeys.begin(), contextKeys.end(), key))
+            added.insert(added.end(), local.indices.begin() + i, local.indices.begin() + i + 3);
+    }
+
+    //Surviving triangles keep their order and are followed by the new ones. Vertices keep their order as well,
+    //new vertices go last and vertices no triangle uses any more are dropped.
+    vector<int> globalRemap = vector<int>(mesh.VertexCount(), -1), localRemap = vector<int>(local.VertexCount(), -1);
+    for (int t = 0; t < mesh.TriangleCount(); t++) {
+        if (!removed[t])
+            for (int k = 0; k < 3; k++)
+                globalRemap[indices[t * 3 + k]] = 0;
+    }
+    for (const int v: added) {
+        if (v < fixedCount)
+            globalRemap[localToGlobal[v]] = 0;
+        else
+            localRemap[v] = 0;
+    }
+
+    NavMeshData patched = NavMeshData();
+    for (int v = 0; v < mesh.VertexCount(); v++) {
+        if (globalRemap[v] != -1)
+            globalRemap[v] = patched.AddVertex(mesh.Vertex(v));
+    }
+    for (int v = fixedCount; v < local.VertexCount(); v++) {
+        if (localRemap[v] != -1)
+            localRemap[v] = patched.AddVertex(local.Vertex(v));
+    }
+
+    vector<int> triangleRemap = vector<int>(mesh.TriangleCount(), -1);
+    patched.indices.reserve(indices.size() + added.size());
+    patched.triangles.reserve(indices.size() / 3 + added.size() / 3);
+    for (int t = 0; t < mesh.TriangleCount(); t++) {
+        if (removed[t])
+            continue;
+
+        triangleRemap[t] = patched.TriangleCount();
+        for (int k = 0; k < 3; k++)
+            patched.indices.push_back(globalRemap[indices[t * 3 + k]]);
+    }
+    const int firstNewTriangle = patched.TriangleCount();
+    for (const int v: added)
+        patched.indices.push_back(v < fixedCount ? globalRemap[localToGlobal[v]] : localRemap[v]);
+
+    for (int t = 0; t < mesh.TriangleCount(); t++) {
+        if (removed[t])
+            continue;
+
+        patched.triangles.push_back(mesh.triangles[t]);
+        patched.triangles.back().Remap(triangleRemap[t], globalRemap, triangleRemap);
+    }
+    for (int i = firstNewTriangle * 3; i < (int) patched.indices.size(); i += 3)
+        patched.triangles.emplace_back(i / 3, patched.indices[i], patched.indices[i + 1], patched.indices[i + 2]);
+
+#pragma endregion
+
+#pragma region Relink the triangles around the region
+
+    //Only edges between two touched vertices, those of removed or new triangles, can have gained or lost a
+    //triangle, so only triangles with such an edge are relinked. Every triangle sharing a vertex with them goes
+    //into the local edge table, so it holds all triangles on their edges.
+    vector<uint8_t> touched = vector<uint8_t>(patched.VertexCount(), 0);
+    for (int t = 0; t < mesh.TriangleCount(); t++) {
+        if (removed[t])
+            for (int k = 0; k < 3; k++)
+                if (globalRemap[indices[t * 3 + k]] != -1)
+                    touched[globalRemap[indices[t * 3 + k]]] = 1;
+    }
+    for (int i = firstNewTriangle * 3; i < (int) patched.indices.size(); i++)
+        touched[patched.indices[i]] = 1;
+
+    vector<int> vertexTriangleStart = vector<int>(patched.VertexCount() + 1, 0), vertexTriangles = vector<int>();
+    for (const int v: patched.indices)
+        vertexTriangleStart[v + 1]++;
+    for (int v = 0; v < patched.VertexCount(); v++)
+        vertexTriangleStart[v + 1] += vertexTriangleStart[v];
+    vertexTriangles.resize(patched.indices.size());
+    vector<int> fill = vector<int>(vertexTriangleStart.begin(), vertexTriangleStart.end() - 1);
+    for (int i = 0; i < (int) patched.indices.size(); i++)
+        vertexTriangles[fill[patched.indices[i]]++] = i / 3;
+
+    vector<uint8_t> relink = vector<uint8_t>(patched.TriangleCount(), 0),
+            inTable = vector<uint8_t>(patched.TriangleCount(), 0);
+    vector<int> table = vector<int>();
+    for (int v = 0; v < patched.VertexCount(); v++) {
+        if (!touched[v])
+            continue;
+
+        for (int e = vertexTriangleStart[v]; e < vertexTriangleStart[v + 1]; e++) {
+            const int t = vertexTriangles[e];
+            const int a = patched.indices[t * 3], b = patched.indices[t * 3 + 1], c = patched.indices[t * 3 + 2];
+            if (relink[t] || (int) touched[a] + (int) touched[b] + (int) touched[c] < 2)
+                continue;
+
+            relink[t] = 1;
+
+            for (const int corner: {a, b, c}) {
+                for (int o = vertexTriangleStart[corner]; o < vertexTriangleStart[corner + 1]; o++) {
+                    if (!inTable[vertexTriangles[o]]) {
+                        inTable[vertexTriangles[o]] = 1;
+                        table.push_back(vertexTriangles[o]);
+                    }
+                }
+            }
+        }
+    }
+
+    //Local ids in ascending global order give the same neighbor order as a full rebuild.
+    sort(table.begin(), table.end());
+    vector<int> tableIndices = vector<int>();
+    vector<NavMeshTriangle> tableTriangles = vector<NavMeshTriangle>();
+    tableIndices.reserve(table.size() * 3);
+    tableTriangles.reserve(table.size());
+    for (int i = 0; i < (int) table.size(); i++) {
+        const NavMeshTriangle &triangle = patched.triangles[table[i]];
+        tableIndices.insert(tableIndices.end(), {triangle.GetA(), triangle.GetB(), triangle.GetC()});
+        tableTriangles.emplace_back(i, triangle.GetA(), triangle.GetB(), triangle.GetC());
+    }
+
+    EdgeAdjacency adjacency = EdgeAdjacency();
+    adjacency.Build(tableIndices, patched.VertexCount());
+    adjacency.SetupNeighbors(tableTriangles);
+
+    vector<int> neighbors = vector<int>();
+    for (int i = 0; i < (int) table.size(); i++) {
+        NavMeshTriangle &triangle = patched.triangles[table[i]];
+        if (!relink[table[i]])
+            continue;
+
+        neighbors.clear();
+        for (int k = 0; k < tableTriangles[i].neighborCount(); k++)
+            neighbors.push_back(table[tableTriangles[i].neighbor(k)]);
+
+        triangle.SetNeighborIds(neighbors);
+        triangle.SetBorderWidth(patched);
+    }
+
+    //The same holds for non-manifold edges, those between two touched vertices are taken from the local table.
+    vector<Vector2Int> nonManifoldEdges = vector<Vector2Int>();
+    for (const Vector2Int &edge: optimized.getNonManifoldEdges()) {
+        const int u = globalRemap[edge.x], v = globalRemap[edge.y];
+        if (u != -1 && v != -1 && !(touched[u] && touched[v]))
+            nonManifoldEdges.emplace_back(u, v);
+    }
+    for (const Vector2Int &edge: adjacency.NonManifoldEdges()) {
+        if (touched[edge.x] && touched[edge.y])
+            nonManifoldEdges.push_back(edge);
+    }
+    sort(nonManifoldEdges.begin(), nonManifoldEdges.end());
+
+#pragma endregion
+
+    optimized.PatchValues(patched, groupSize, triangleRemap, firstNewTriangle);
+    optimized.SetNonManifoldEdges(nonManifoldEdges);
+}
+
+void ReoptimizeNavMesh(NavMeshOptimized &optimized, const NavMeshData &replacement, ThreadPool *pool) {
+    if (replacement.VertexCount() == 0)
+        return;
+
+    Vector3 dirtyMin = replacement.Vertex(0), dirtyMax = replacement.Vertex(0);
+    for (int i = 1; i < replacement.VertexCount(); i++) {
+        dirtyMin = Vector3(MathC::Min(dirtyMin.x, replacement.x[i]), MathC::Min(dirtyMin.y, replacement.y[i]),
+                           MathC::Min(dirtyMin.z, replacement.z[i]));
+        dirtyMax = Vector3(MathC::Max(dirtyMax.x, replacement.x[i]), MathC::Max(dirtyMax.y, replacement.y[i]),
+                           MathC::Max(dirtyMax.z, replacement.z[i]));
+    }
+
+    ReoptimizeNavMesh(optimized, dirtyMin, dirtyMax, replacement, pool);
+}
+
+void SetupNavTriangles(NavMeshData &mesh, pmr::map<int, pmr::vector<int>> &trianglesByVertexID) {
+    PROFILE_SCOPE("SetupNavTriangles");
+
+    const vector<int> &indices = mesh.indices;
+    vector<NavMeshTriangle> &triangles = mesh.triangles;
+    triangles.clear();
+    triangles.reserve(indices.size() / 3);
+
+    for (int i = 0; i < (int) indices.size(); i += 3) {
+        int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        NavMeshTriangle triangle = NavMeshTriangle(i / 3, a, b, c);
+
+        triangles.push_back(triangle);
+
+        int tID = (int) triangles.size() - 1;
+
+        if (trianglesByVertexID.find(a) == trianglesByVertexID.end())
+            trianglesByVertexID.insert({a, pmr::vector<int>()});
+
+        if (trianglesByVertexID.find(b) == trianglesByVertexID.end())
+            trianglesByVertexID.insert({b, pmr::vector<int>()});
+
+        if (trianglesByVertexID.find(c) == trianglesByVertexID.end())
+            trianglesByVertexID.insert({c, pmr::vector<int>()});
+
+        trianglesByVertexID[a].push_back(tID);
+        trianglesByVertexID[b].push_back(tID);
+        trianglesByVertexID[c].push_back(tID);
+    }
+}
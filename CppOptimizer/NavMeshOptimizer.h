@@ -0,0 +1,76 @@
+#ifndef CPPOPTIMIZER_NAVMESHOPTIMIZER_H
+#define CPPOPTIMIZER_NAVMESHOPTIMIZER_H
+
+#include <map>
+#include <memory_resource>
+#include <vector>
+#include "HoleFiller.h"
+#include "NavMeshData.h"
+#include "NavMeshOptimized.h"
+#include "ThreadPool.h"
+#include "Vector3.h"
+
+using namespace std;
+
+/// <summary>
+///     Welds the mesh, keeps the triangles connected to the triangles nearest the clean point, fills the holes
+///     and links the final triangles. The input mesh is modified in place.
+/// </summary>
+/// <param name="pool">Optional pool the hole filling runs on.</param>
+/// <param name="minIslandTriangles">
+///     Islands not connected to the clean point are kept as well when they hold at least this many triangles,
+///     0 keeps only the island of the clean point.
+/// </param>
+/// <param name="arena">
+///     Optional resource for the temporary lookups, such as a monotonic_buffer_resource over a reused buffer that
+///     is released between runs, so repeated runs do not go to the heap for them. Null uses a monotonic resource
+///     local to the call. The result does not use it.
+/// </param>
+/// <param name="holeFillMode">How holes are closed, see HoleFillMode.</param>
+/// <param name="decimate">
+///     Collapses vertices on flat parts of the filled mesh with MeshDecimator before the triangles are linked, for
+///     fewer triangles to search at runtime.
+/// </param>
+NavMeshOptimized OptimizeNavMesh(Vector3 cleanPoint, NavMeshData &mesh, ThreadPool *pool,
+                                 int minIslandTriangles = 0, pmr::memory_resource *arena = nullptr,
+                                 HoleFillMode holeFillMode = HoleFillMode::Candidates, bool decimate = false);
+
+/// <summary>
+///     Tiled variant of OptimizeNavMesh for worlds too large for a single pass. The triangles are split into square
+///     XZ tiles by their center, and every tile is welded and later hole filled on its own, in parallel on the pool.
+///     A seam pass welds the vertices along the tile borders, while keeping the clean point's connected part and
+///     linking the triangles across tiles runs over the whole mesh, as both are linear. Holes spanning a tile
+///     border are left open by the tiles and closed afterwards by HoleFiller::FillHoleLoops on the merged mesh.
+///     The input mesh is left unchanged.
+/// </summary>
+NavMeshOptimized OptimizeNavMeshTiled(Vector3 cleanPoint, const NavMeshData &mesh, float tileSize, ThreadPool *pool,
+                                      int minIslandTriangles = 0,
+                                      HoleFillMode holeFillMode = HoleFillMode::Candidates, bool decimate = false);
+
+/// <summary>
+///     Patches an optimized mesh after a local edit, such as a door opening or a wall breaking, without a full
+///     rebake. The triangles whose bounds overlap the dirty box are replaced by the replacement triangles, which are
+///     welded onto the surrounding triangles, and holes are filled around them. Existing vertices stay where they
+///     are, and islands are not reevaluated, so rerun OptimizeNavMesh now and then after many edits.
+/// </summary>
+/// <param name="replacement">New triangles for the dirty box in world space, may be empty to only remove.</param>
+void ReoptimizeNavMesh(NavMeshOptimized &optimized, const Vector3 &dirtyMin, const Vector3 &dirtyMax,
+                       const NavMeshData &replacement, ThreadPool *pool);
+
+/// <summary>
+///     Patches an optimized mesh with changed triangles, replacing the triangles within their bounds.
+/// </summary>
+void ReoptimizeNavMesh(NavMeshOptimized &optimized, const NavMeshData &replacement, ThreadPool *pool);
+
+/// <summary>
+///     Lists the triangles connected to the triangles nearest the clean point, followed by the islands kept for
+///     their size. Expects the linked triangles and triangle lists per vertex of SetupNavTriangles.
+/// </summary>
+vector<int> KeepConnected(const Vector3 &cleanPoint, const NavMeshData &mesh,
+                          pmr::map<int, pmr::vector<int>> &trianglesByVertexId, int minIslandTriangles,
+                          vector<int> &islandSizes, vector<int> &keptIslands);
+
+void SetupNavTriangles(NavMeshData &mesh, pmr::map<int, pmr::vector<int>> &trianglesByVertexId);
+
+
+#endif //CPPOPTIMIZER_NAVMESHOPTIMIZER_H
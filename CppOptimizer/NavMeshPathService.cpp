@@ -0,0 +1,34 @@
+#include "NavMeshPathService.h"
+
+using namespace std;
+
+NavMeshPathService::NavMeshPathService(const NavMeshPathfinder &pathfinder, ThreadPool *pool)
+        : pathfinder_(pathfinder), pool_(pool) {
+    arenas_ = vector<Arena>(pool == nullptr ? 1 : pool->ThreadCount());
+}
+
+void NavMeshPathService::FindPaths(const PathRequest *requests, const int count, vector<PathResult> &results) {
+    //Queries take a few microseconds each, so chunks amortize the claiming.
+    const int grain = 16;
+
+    results.resize(count);
+    for (Arena &arena: arenas_)
+        arena.points.clear();
+
+    ThreadPool::ParallelFor(pool_, count, grain, [&](int begin, int end, int worker) {
+        Arena &arena = arenas_[worker];
+
+        for (int i = begin; i < end; i++) {
+            PathResult &result = results[i];
+            result.found = pathfinder_.FindPath(requests[i].start, requests[i].goal, arena.query, arena.path);
+            result.arena = worker;
+            result.offset = (int) arena.points.size();
+            result.count = (int) arena.path.size();
+            arena.points.insert(arena.points.end(), arena.path.begin(), arena.path.end());
+        }
+    });
+}
+
+const Vector3 *NavMeshPathService::PathPoints(const PathResult &result) const {
+    return arenas_[result.arena].points.data() + result.offset;
+}
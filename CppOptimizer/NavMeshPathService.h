@@ -0,0 +1,57 @@
+#ifndef CPPOPTIMIZER_NAVMESHPATHSERVICE_H
+#define CPPOPTIMIZER_NAVMESHPATHSERVICE_H
+
+#include <vector>
+#include "NavMeshPathfinder.h"
+#include "ThreadPool.h"
+#include "Vector3.h"
+
+using namespace std;
+
+struct PathRequest {
+    Vector3 start, goal;
+};
+
+/// <summary>
+///     Outcome of one request. The path points are stored in the arena of the worker that ran the request.
+/// </summary>
+struct PathResult {
+    bool found;
+    int arena, offset, count;
+};
+
+/// <summary>
+///     Runs batches of path requests on a thread pool.
+///     Requests are handed out in chunks to the pool workers. Every worker owns an arena with its query scratch
+///     and the path points it produced, so workers share nothing but the immutable pathfinder and need no locks.
+///     Arenas keep their capacity between batches, so steady batches do not allocate.
+///     One batch runs at a time per service, the paths of a batch stay valid until the next batch starts.
+/// </summary>
+class NavMeshPathService {
+private:
+    struct Arena {
+        NavMeshPathQuery query;
+        vector<Vector3> path, points;
+    };
+
+    const NavMeshPathfinder &pathfinder_;
+    ThreadPool *pool_;
+    vector<Arena> arenas_;
+
+public:
+    /// <param name="pool">Pool to run the batches on, null runs them on the calling thread.</param>
+    NavMeshPathService(const NavMeshPathfinder &pathfinder, ThreadPool *pool);
+
+    /// <summary>
+    ///     Answers count requests, results[i] belongs to requests[i].
+    /// </summary>
+    void FindPaths(const PathRequest *requests, int count, vector<PathResult> &results);
+
+    /// <summary>
+    ///     First point of the path of a result from the current batch, the path holds result.count points.
+    /// </summary>
+    const Vector3 *PathPoints(const PathResult &result) const;
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHPATHSERVICE_H
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "NavMeshPathfinder.h"
+
+using namespace std;
+
+/// <summary>
+///     Twice the signed area of the triangle a, b, c in the XZ plane.
+/// </summary>
+static float TriArea2(const float *a, const float *b, const float *c) {
+    const float abx = b[0] - a[0], abz = b[2] - a[2],
+            acx = c[0] - a[0], acz = c[2] - a[2];
+    return acx * abz - abx * acz;
+}
+
+static bool SamePoint(const float *a, const float *b) {
+    const float dx = a[0] - b[0], dz = a[2] - b[2];
+    return dx * dx + dz * dz < 1e-12f;
+}
+
+static void AddPathPoint(vector<Vector3> &path, const float *p) {
+    const Vector3 &last = path.back();
+    if (last.x != p[0] || last.y != p[1] || last.z != p[2])
+        path.emplace_back(p[0], p[1], p[2]);
+}
+
+void NavMeshPathQuery::Begin(const int triangleCount) {
+    if ((int) cost_.size() != triangleCount) {
+        cost_.assign(triangleCount, 0.0f);
+        parent_.assign(triangleCount, -1);
+        openStamp_.assign(triangleCount, 0);
+        closedStamp_.assign(triangleCount, 0);
+        generation_ = 0;
+    }
+
+    generation_++;
+    if (generation_ == 0) {
+        fill(openStamp_.begin(), openStamp_.end(), 0);
+        fill(closedStamp_.begin(), closedStamp_.end(), 0);
+        generation_ = 1;
+    }
+
+    open_.clear();
+    corridor_.clear();
+    entrances_.clear();
+    portals_.clear();
+}
+
+NavMeshPathfinder::NavMeshPathfinder(const NavMeshData &mesh, const float cellSize,
+                                     const NavMeshHierarchy *hierarchy) : mesh_(mesh), hierarchy_(hierarchy) {
+    const int triangleCount = mesh.TriangleCount();
+    const vector<int> &indices = mesh.indices;
+
+    centerX_.resize(triangleCount);
+    centerY_.resize(triangleCount);
+    centerZ_.resize(triangleCount);
+
+    locator_.Build(mesh, cellSize);
+
+    for (int t = 0; t < triangleCount; t++) {
+        const int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+
+        centerX_[t] = (mesh.x[a] + mesh.x[b] + mesh.x[c]) / 3.0f;
+        centerY_[t] = (mesh.y[a] + mesh.y[b] + mesh.y[c]) / 3.0f;
+        centerZ_[t] = (mesh.z[a] + mesh.z[b] + mesh.z[c]) / 3.0f;
+    }
+}
+
+int NavMeshPathfinder::FindTriangle(const Vector3 &point) const {
+    return locator_.FindTriangle(mesh_, point);
+}
+
+float NavMeshPathfinder::Heuristic(const int t, const Vector3 &goal) const {
+    const float dx = centerX_[t] - goal.x, dy = centerY_[t] - goal.y, dz = centerZ_[t] - goal.z;
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+bool NavMeshPathfinder::FindCorridor(const int startTriangle, const int goalTriangle, const Vector3 &goal,
+                                     const float agentRadius, NavMeshPathQuery &query) const {
+    const uint32_t generation = query.generation_;
+    const float minWidth = agentRadius * 2.0f;
+
+    query.cost_[startTriangle] = 0;
+    query.parent_[startTriangle] = -1;
+    query.openStamp_[startTriangle] = generation;
+    query.open_.push_back({Heuristic(startTriangle, goal), startTriangle});
+
+    //Centers are joined by straight lines, so the distance to the goal never overestimates and a triangle is
+    //final the first time it leaves the open list. Stale entries left behind by cheaper updates are skipped.
+    while (!query.open_.empty()) {
+        pop_heap(query.open_.begin(), query.open_.end(), greater<>());
+        const int t = query.open_.back().triangle;
+        query.open_.pop_back();
+
+        if (query.closedStamp_[t] == generation)
+            continue;
+        query.closedStamp_[t] = generation;
+
+        if (t == goalTriangle)
+            break;
+
+        const NavMeshTriangle &triangle = mesh_.triangles[t];
+        for (int k = 0; k < triangle.neighborCount(); k++) {
+            const int n = triangle.neighbor(k);
+            if (triangle.portalLeft(k) == -1 || triangle.borderWidth(k) < minWidth ||
+                query.closedStamp_[n] == generation)
+                continue;
+
+            const float cost = query.cost_[t] + triangle.neighborDistance(k);
+
+            if (query.openStamp_[n] == generation && cost >= query.cost_[n])
+                continue;
+
+            query.openStamp_[n] = generation;
+            query.cost_[n] = cost;
+            query.parent_[n] = t;
+            query.open_.push_back({cost + Heuristic(n, goal), n});
+            push_heap(query.open_.begin(), query.open_.end(), greater<>());
+        }
+    }
+
+    if (query.closedStamp_[goalTriangle] != generation)
+        return false;
+
+    for (int t = goalTriangle; t != -1; t = query.parent_[t])
+        query.corridor_.push_back(t);
+    reverse(query.corridor_.begin(), query.corridor_.end());
+    return true;
+}
+
+bool NavMeshPathfinder::FindCorridorHierarchical(const int startTriangle, const int goalTriangle, const Vector3 &goal,
+                                                 NavMeshPathQuery &query) const {
+    const NavMeshHierarchy &hierarchy = *hierarchy_;
+    const uint32_t generation = query.generation_;
+    const int goalCluster = hierarchy.Cluster(goalTriangle);
+
+    const int32_t *entrance = hierarchy.EntrancesBegin(hierarchy.Cluster(startTriangle));
+    for (; entrance != hierarchy.EntrancesEnd(hierarchy.Cluster(startTriangle)); entrance++) {
+        const float cost = hierarchy.TreeCost(*entrance, startTriangle);
+        if (isinf(cost))
+            continue;
+
+        query.cost_[*entrance] = cost;
+        query.parent_[*entrance] = -1;
+        query.openStamp_[*entrance] = generation;
+        query.open_.push_back({cost + Heuristic(*entrance, goal), *entrance});
+    }
+    make_heap(query.open_.begin(), query.open_.end(), greater<>());
+
+    //The goal is entered into the open list as -1 from every entrance of its cluster, the first time it leaves
+    //the list it is reached at the lowest cost. Its key carries the heuristic of the goal triangle like every other
+    //key, as the heuristic measures to the goal point and not to the triangle the trees end at.
+    float goalCost = numeric_limits<float>::infinity();
+    int goalParent = -1;
+    bool reached = false;
+
+    while (!query.open_.empty()) {
+        pop_heap(query.open_.begin(), query.open_.end(), greater<>());
+        const int t = query.open_.back().triangle;
+        query.open_.pop_back();
+
+        if (t == -1) {
+            reached = true;
+            break;
+        }
+
+        if (query.closedStamp_[t] == generation)
+            continue;
+        query.closedStamp_[t] = generation;
+
+        if (hierarchy.Cluster(t) == goalCluster) {
+            const float cost = query.cost_[t] + hierarchy.TreeCost(t, goalTriangle);
+            if (cost < goalCost) {
+                goalCost = cost;
+                goalParent = t;
+                query.open_.push_back({cost + Heuristic(goalTriangle, goal), -1});
+                push_heap(query.open_.begin(), query.open_.end(), greater<>());
+            }
+        }
+
+        for (int e = hierarchy.EdgesBegin(t); e < hierarchy.EdgesEnd(t); e++) {
+            const int n = hierarchy.EdgeTarget(e);
+            if (query.closedStamp_[n] == generation)
+                continue;
+
+            const float cost = query.cost_[t] + hierarchy.EdgeCost(e);
+            if (query.openStamp_[n] == generation && cost >= query.cost_[n])
+                continue;
+
+            query.openStamp_[n] = generation;
+            query.cost_[n] = cost;
+            query.parent_[n] = t;
+            query.open_.push_back({cost + Heuristic(n, goal), n});
+            push_heap(query.open_.begin(), query.open_.end(), greater<>());
+        }
+    }
+
+    if (!reached)
+        return false;
+
+    vector<int> &entrances = query.entrances_, &corridor = query.corridor_;
+    for (int t = goalParent; t != -1; t = query.parent_[t])
+        entrances.push_back(t);
+    reverse(entrances.begin(), entrances.end());
+
+    //Entrances in the same cluster are joined along the tree of the later one, the others are neighbors.
+    for (int t = startTriangle; t != -1; t = hierarchy.TreeNext(entrances[0], t))
+        corridor.push_back(t);
+
+    for (int i = 1; i < (int) entrances.size(); i++) {
+        if (hierarchy.Cluster(entrances[i - 1]) != hierarchy.Cluster(entrances[i])) {
+            corridor.push_back(entrances[i]);
+            continue;
+        }
+
+        const int target = entrances[i];
+        for (int t = hierarchy.TreeNext(target, entrances[i - 1]); t != -1; t = hierarchy.TreeNext(target, t))
+            corridor.push_back(t);
+    }
+
+    //The tree of the last entrance leads from the goal to it, so that part is walked backwards.
+    const size_t size = corridor.size();
+    for (int t = goalTriangle; t != entrances.back(); t = hierarchy.TreeNext(entrances.back(), t))
+        corridor.push_back(t);
+    reverse(corridor.begin() + (long) size, corridor.end());
+
+    return true;
+}
+
+bool NavMeshPathfinder::StringPull(const Vector3 &start, const Vector3 &goal, NavMeshPathQuery &query,
+                                   vector<Vector3> &path) const {
+    vector<float> &portals = query.portals_;
+    const vector<int> &corridor = query.corridor_;
+
+    //Portals as left and right points seen when walking the corridor, six floats each. The start and the goal
+    //are degenerate portals at both ends.
+    auto addPortal = [&portals](const float *left, const float *right) {
+        portals.insert(portals.end(), left, left + 3);
+        portals.insert(portals.end(), right, right + 3);
+    };
+
+    const float startPoint[3] = {start.x, start.y, start.z}, goalPoint[3] = {goal.x, goal.y, goal.z};
+    addPortal(startPoint, startPoint);
+
+    for (int i = 0; i + 1 < (int) corridor.size(); i++) {
+        const int t = corridor[i], next = corridor[i + 1];
+
+        const NavMeshTriangle &triangle = mesh_.triangles[t];
+        int k = 0;
+        while (k < triangle.neighborCount() && triangle.neighbor(k) != next)
+            k++;
+        if (k == triangle.neighborCount() || triangle.portalLeft(k) == -1)
+            return false;
+
+        const int l = triangle.portalLeft(k), r = triangle.portalRight(k);
+        const float pl[3] = {mesh_.x[l], mesh_.y[l], mesh_.z[l]},
+                pr[3] = {mesh_.x[r], mesh_.y[r], mesh_.z[r]};
+        addPortal(pl, pr);
+    }
+
+    addPortal(goalPoint, goalPoint);
+
+    //Simple stupid funnel algorithm. The funnel narrows portal by portal, and when one side crosses the other
+    //the apex moves to the crossed corner, which becomes a path point, and the scan restarts from there.
+    const int portalCount = (int) portals.size() / 6;
+    const float *apex = &portals[0], *left = &portals[0], *right = &portals[3];
+    int apexIndex = 0, leftIndex = 0, rightIndex = 0;
+
+    path.emplace_back(start.x, start.y, start.z);
+
+    for (int i = 1; i < portalCount; i++) {
+        const float *nextLeft = &portals[i * 6], *nextRight = &portals[i * 6 + 3];
+
+        if (TriArea2(apex, right, nextRight) <= 0.0f) {
+            if (SamePoint(apex, right) || TriArea2(apex, left, nextRight) > 0.0f) {
+                right = nextRight;
+                rightIndex = i;
+            }
+            else {
+                AddPathPoint(path, left);
+                apex = left;
+                apexIndex = leftIndex;
+                right = apex;
+                rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        if (TriArea2(apex, left, nextLeft) >= 0.0f) {
+            if (SamePoint(apex, left) || TriArea2(apex, right, nextLeft) < 0.0f) {
+                left = nextLeft;
+                leftIndex = i;
+            }
+            else {
+                AddPathPoint(path, right);
+                apex = right;
+                apexIndex = rightIndex;
+                left = apex;
+                leftIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    AddPathPoint(path, goalPoint);
+    return true;
+}
+
+bool NavMeshPathfinder::FindPath(const Vector3 &start, const Vector3 &goal, NavMeshPathQuery &query,
+                                 vector<Vector3> &path, const float agentRadius) const {
+    path.clear();
+    if ((int) mesh_.triangles.size() != mesh_.TriangleCount())
+        return false;
+
+    query.Begin(mesh_.TriangleCount());
+
+    const int startTriangle = FindTriangle(start), goalTriangle = FindTriangle(goal);
+    if (startTriangle == -1 || goalTriangle == -1)
+        return false;
+
+    const bool hierarchical = hierarchy_ != nullptr && agentRadius == 0.0f &&
+                              hierarchy_->Cluster(startTriangle) != hierarchy_->Cluster(goalTriangle);
+    if (hierarchical ? !FindCorridorHierarchical(startTriangle, goalTriangle, goal, query)
+                     : !FindCorridor(startTriangle, goalTriangle, goal, agentRadius, query))
+        return false;
+
+    if (!StringPull(start, goal, query, path)) {
+        path.clear();
+        return false;
+    }
+    return true;
+}
+
+const vector<int> &NavMeshPathfinder::Corridor(const NavMeshPathQuery &query) {
+    return query.corridor_;
+}
@@ -0,0 +1,110 @@
+#ifndef CPPOPTIMIZER_NAVMESHPATHFINDER_H
+#define CPPOPTIMIZER_NAVMESHPATHFINDER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "GeometryPolicy.h"
+#include "NavMeshData.h"
+#include "NavMeshHierarchy.h"
+#include "TriangleLocator.h"
+#include "Vector3.h"
+
+using namespace std;
+
+/// <summary>
+///     Scratch buffers for path queries. One query object is used by one thread at a time, and after the first
+///     queries on a mesh it has grown to size so later queries do not allocate.
+/// </summary>
+class NavMeshPathQuery {
+private:
+    friend class NavMeshPathfinder;
+
+    struct OpenNode {
+        float f;
+        int triangle;
+
+        bool operator>(const OpenNode &b) const {
+            return f > b.f;
+        }
+    };
+
+    //A triangle's cost and parent are only valid when its stamp equals the query generation, so nothing is cleared
+    //between queries.
+    vector<float> cost_;
+    vector<int> parent_;
+    vector<uint32_t> openStamp_, closedStamp_;
+    uint32_t generation_ = 0;
+
+    vector<OpenNode> open_;
+    vector<int> corridor_, entrances_;
+    vector<float> portals_;
+
+    void Begin(int triangleCount);
+};
+
+/// <summary>
+///     Path queries over an optimized navigation mesh.
+///     Start and goal are located through a TriangleLocator, A* runs over the triangle neighbor
+///     graph between triangle centers, and the triangle corridor found is straightened with the funnel algorithm
+///     in the XZ plane. Edge costs and portals are read from the triangles, so the mesh needs its neighbors and
+///     border widths set, as OptimizeNavMesh leaves them. The pathfinder is immutable after construction and can be
+///     shared between threads, each with its own NavMeshPathQuery. The mesh must outlive the pathfinder.
+/// </summary>
+class NavMeshPathfinder {
+private:
+    const NavMeshData &mesh_;
+    const NavMeshHierarchy *hierarchy_;
+    TriangleLocator locator_;
+
+    vector<float> centerX_, centerY_, centerZ_;
+
+    float Heuristic(int t, const Vector3 &goal) const;
+
+    bool FindCorridor(int startTriangle, int goalTriangle, const Vector3 &goal, float agentRadius,
+                      NavMeshPathQuery &query) const;
+
+    /// <summary>
+    ///     FindCorridor through the abstract graph of the hierarchy. The start is joined to the entrances of its
+    ///     cluster and the entrances of the goal cluster to the goal along their trees, and the entrances found are
+    ///     expanded into triangles along the trees. Triangle costs and parents are indexed by entrance.
+    /// </summary>
+    bool FindCorridorHierarchical(int startTriangle, int goalTriangle, const Vector3 &goal,
+                                  NavMeshPathQuery &query) const;
+
+    /// <returns>False when two triangles following each other in the corridor do not share a portal.</returns>
+    bool StringPull(const Vector3 &start, const Vector3 &goal, NavMeshPathQuery &query, vector<Vector3> &path) const;
+
+public:
+    /// <param name="cellSize">Cell size of the grid used to locate points.</param>
+    /// <param name="hierarchy">
+    ///     Optional cluster hierarchy built for the mesh. Queries between different clusters without an agent radius
+    ///     then search its abstract graph, the others run A* over the triangles. Must outlive the pathfinder.
+    /// </param>
+    explicit NavMeshPathfinder(const NavMeshData &mesh, float cellSize = DefaultPolicy::groupSize,
+                               const NavMeshHierarchy *hierarchy = nullptr);
+
+    /// <summary>
+    ///     Triangle containing the point in the XZ plane. When triangles overlap, as on stacked floors, the one
+    ///     closest to the point in height is returned.
+    /// </summary>
+    /// <returns>The triangle id or -1 when the point is off the mesh.</returns>
+    int FindTriangle(const Vector3 &point) const;
+
+    /// <summary>
+    ///     Finds the shortest corridor between the triangles under start and goal and fills path with the
+    ///     straightened path from start to goal, both included.
+    /// </summary>
+    /// <param name="agentRadius">Portals narrower than twice the radius are not crossed.</param>
+    /// <returns>False and an empty path when either point is off the mesh or the goal can not be reached.</returns>
+    bool FindPath(const Vector3 &start, const Vector3 &goal, NavMeshPathQuery &query, vector<Vector3> &path,
+                  float agentRadius = 0.0f) const;
+
+    /// <summary>
+    ///     Corridor of the last successful query, from the start triangle to the goal triangle.
+    /// </summary>
+    static const vector<int> &Corridor(const NavMeshPathQuery &query);
+};
+
+
+#endif //CPPOPTIMIZER_NAVMESHPATHFINDER_H
@@ -1,4 +1,5 @@
 #include "NavMeshTriangle.h"
+#include "NavMeshData.h"
 #include "MathC.h"
 
 using namespace std;
@@ -8,29 +9,47 @@ NavMeshTriangle::NavMeshTriangle(int id_in, int a_in, int b_in, int c_in) {
     a_ = a_in;
     b_ = b_in;
     c_ = c_in;
-    neighbor_ids_ =  std::vector<int>(3, 0);
-    width_distance_between_neighbors_ =  std::vector<float>(3, 0);
+    neighbor_count_ = 0;
+    for (int i = 0; i < 3; i++)
+        neighbor_ids_[i] = -1;
+    ClearBorders();
 }
 
-int NavMeshTriangle::id() {
+void NavMeshTriangle::ClearBorders() {
+    for (int i = 0; i < 3; i++) {
+        portal_left_[i] = -1;
+        portal_right_[i] = -1;
+        width_distance_between_neighbors_[i] = 0;
+        center_distance_to_neighbors_[i] = 0;
+    }
+}
+
+int NavMeshTriangle::id() const {
     return id_;
 }
 
-vector<int> NavMeshTriangle::vertices() {
-    return  {a_, b_, c_};
+array<int, 3> NavMeshTriangle::vertices() const {
+    return {a_, b_, c_};
+}
+
+int NavMeshTriangle::neighborCount() const {
+    return neighbor_count_;
 }
 
-vector<int>NavMeshTriangle::neighbors() {
-    return neighbor_ids_;
+int NavMeshTriangle::neighbor(int i) const {
+    return neighbor_ids_[i];
 }
 
 void NavMeshTriangle::SetNeighborIds(const vector<int> &set) {
-    neighbor_ids_.clear();
+    neighbor_count_ = 0;
     for (const int &element: set) {
+        if (neighbor_count_ == 3)
+            break;
+
         bool exist = false;
 
-        for (const int n: neighbor_ids_) {
-            if (element != n)
+        for (int i = 0; i < neighbor_count_; i++) {
+            if (element != neighbor_ids_[i])
                 continue;
 
             exist = true;
@@ -38,22 +57,107 @@ void NavMeshTriangle::SetNeighborIds(const vector<int> &set) {
         }
 
         if (!exist)
-            neighbor_ids_.push_back(element);
+            neighbor_ids_[neighbor_count_++] = element;
+    }
+
+    for (int i = neighbor_count_; i < 3; i++)
+        neighbor_ids_[i] = -1;
+
+    //Portals of the old neighbors no longer apply.
+    ClearBorders();
+}
+
+void NavMeshTriangle::Remap(const int id_in, const vector<int> &vertexRemap, const vector<int> &triangleRemap) {
+    id_ = id_in;
+    a_ = vertexRemap[a_];
+    b_ = vertexRemap[b_];
+    c_ = vertexRemap[c_];
+
+    int kept = 0;
+    for (int i = 0; i < neighbor_count_; i++) {
+        const int n = triangleRemap[neighbor_ids_[i]];
+        if (n == -1)
+            continue;
+
+        neighbor_ids_[kept] = n;
+        portal_left_[kept] = portal_left_[i] == -1 ? -1 : vertexRemap[portal_left_[i]];
+        portal_right_[kept] = portal_right_[i] == -1 ? -1 : vertexRemap[portal_right_[i]];
+        width_distance_between_neighbors_[kept] = width_distance_between_neighbors_[i];
+        center_distance_to_neighbors_[kept] = center_distance_to_neighbors_[i];
+        kept++;
+    }
+
+    for (int i = kept; i < 3; i++) {
+        neighbor_ids_[i] = -1;
+        portal_left_[i] = -1;
+        portal_right_[i] = -1;
+        width_distance_between_neighbors_[i] = 0;
+        center_distance_to_neighbors_[i] = 0;
     }
+    neighbor_count_ = kept;
 }
 
-int NavMeshTriangle::GetA() {
+int NavMeshTriangle::GetA() const {
     return a_;
 }
 
-int NavMeshTriangle::GetB() {
+int NavMeshTriangle::GetB() const {
     return b_;
 }
 
-int NavMeshTriangle::GetC() {
+int NavMeshTriangle::GetC() const {
     return c_;
 }
 
-void NavMeshTriangle::SetBorderWidth(const vector<Vector3> &verts, vector<NavMeshTriangle> &triangles) {
+int NavMeshTriangle::portalLeft(int i) const {
+    return portal_left_[i];
+}
+
+int NavMeshTriangle::portalRight(int i) const {
+    return portal_right_[i];
+}
+
+float NavMeshTriangle::borderWidth(int i) const {
+    return width_distance_between_neighbors_[i];
+}
+
+float NavMeshTriangle::neighborDistance(int i) const {
+    return center_distance_to_neighbors_[i];
+}
+
+void NavMeshTriangle::SetBorderWidth(const NavMeshData &mesh) {
+    ClearBorders();
+
+    const array<int, 3> own = vertices();
+    const Vector3 center = Vector3((mesh.x[a_] + mesh.x[b_] + mesh.x[c_]) / 3.0f,
+                                   (mesh.y[a_] + mesh.y[b_] + mesh.y[c_]) / 3.0f,
+                                   (mesh.z[a_] + mesh.z[b_] + mesh.z[c_]) / 3.0f);
+
+    for (int i = 0; i < neighbor_count_; i++) {
+        const array<int, 3> other = mesh.triangles[neighbor_ids_[i]].vertices();
+
+        int shared[2], sharedCount = 0;
+        for (const int v: own) {
+            if (sharedCount < 2 && (v == other[0] || v == other[1] || v == other[2]))
+                shared[sharedCount++] = v;
+        }
+        if (sharedCount != 2)
+            continue;
+
+        const int p = shared[0], q = shared[1];
+        const Vector3 a = Vector3(mesh.x[p], mesh.y[p], mesh.z[p]),
+                b = Vector3(mesh.x[q], mesh.y[q], mesh.z[q]);
 
+        //Positive twice signed area in the XZ plane puts a on the left going from the center through the edge.
+        const float area = (b.x - center.x) * (a.z - center.z) - (a.x - center.x) * (b.z - center.z);
+        portal_left_[i] = area > 0 ? p : q;
+        portal_right_[i] = area > 0 ? q : p;
+        width_distance_between_neighbors_[i] = Vector3::Distance(a, b);
+
+        const int na = other[0], nb = other[1], nc = other[2];
+        const Vector3 neighborCenter = Vector3((mesh.x[na] + mesh.x[nb] + mesh.x[nc]) / 3.0f,
+                                               (mesh.y[na] + mesh.y[nb] + mesh.y[nc]) / 3.0f,
+                                               (mesh.z[na] + mesh.z[nb] + mesh.z[nc]) / 3.0f);
+        center_distance_to_neighbors_[i] = Vector3::Distance(center, neighborCenter);
+    }
 }
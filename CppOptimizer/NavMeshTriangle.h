@@ -1,31 +1,73 @@
+#ifndef CPPOPTIMIZER_NAVMESHTRIANGLE_H
+#define CPPOPTIMIZER_NAVMESHTRIANGLE_H
+
+#include <array>
 #include <vector>
 #include "Vector3.h"
 
 using namespace std;
 
+struct NavMeshData;
+
 struct NavMeshTriangle {
 private:
     int id_, a_, b_, c_;
 
-    vector<int> neighbor_ids_;
-    vector<float> width_distance_between_neighbors_;
+    /// <summary>
+    ///     A triangle has at most one neighbor per edge. Extra triangles on non-manifold edges are not linked.
+    /// </summary>
+    int neighbor_ids_[3];
+    int neighbor_count_;
+
+    /// <summary>
+    ///     Per neighbor slot, set by SetBorderWidth: the shared edge as left and right vertex ids seen from this
+    ///     triangle's center looking at the neighbor, the length of that edge and the distance between the centers.
+    ///     Ids are -1 and lengths 0 when the slot is empty or the neighbor does not share exactly two vertices.
+    /// </summary>
+    int portal_left_[3], portal_right_[3];
+    float width_distance_between_neighbors_[3];
+    float center_distance_to_neighbors_[3];
+
+    void ClearBorders();
 
 public:
     NavMeshTriangle(int id_in, int a_in, int b_in, int c_in);
 
-    int id();
+    int id() const;
+
+    array<int, 3> vertices() const;
 
-    vector<int> vertices();
+    int neighborCount() const;
 
-    vector<int> neighbors();
+    int neighbor(int i) const;
 
     void SetNeighborIds(const vector<int> &set);
 
-    void SetBorderWidth(const vector<Vector3> &verts, vector<NavMeshTriangle> &triangles);
+    /// <summary>
+    ///     Renumbers the triangle after vertices and triangles were removed from the mesh, -1 in a remap marks a
+    ///     removed entry. Links to removed neighbors are dropped, the other links keep their order and portals.
+    /// </summary>
+    void Remap(int id_in, const vector<int> &vertexRemap, const vector<int> &triangleRemap);
+
+    /// <summary>
+    ///     Precomputes the portal to each neighbor. Call again after the neighbors or vertex positions change.
+    /// </summary>
+    void SetBorderWidth(const NavMeshData &mesh);
+
+    int portalLeft(int i) const;
+
+    int portalRight(int i) const;
+
+    float borderWidth(int i) const;
+
+    float neighborDistance(int i) const;
+
+    int GetA() const;
+
+    int GetB() const;
 
-    int GetA();
+    int GetC() const;
+};
 
-    int GetB();
 
-    int GetC();
-};
\ No newline at end of file
+#endif //CPPOPTIMIZER_NAVMESHTRIANGLE_H
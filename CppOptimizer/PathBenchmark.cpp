@@ -0,0 +1,145 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NavMeshJsonReader.h"
+#include "NavMeshOptimizer.h"
+#include "NavMeshPathService.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+/// <summary>
+///     Random point on a random triangle of the mesh.
+/// </summary>
+static Vector3 RandomPoint(const NavMeshData &mesh, mt19937 &random) {
+    uniform_int_distribution<int> triangle = uniform_int_distribution<int>(0, mesh.TriangleCount() - 1);
+    uniform_real_distribution<float> weight = uniform_real_distribution<float>(0.0f, 1.0f);
+
+    const int t = triangle(random);
+    float u = weight(random), v = weight(random);
+    if (u + v > 1.0f) {
+        u = 1.0f - u;
+        v = 1.0f - v;
+    }
+
+    const int a = mesh.indices[t * 3], b = mesh.indices[t * 3 + 1], c = mesh.indices[t * 3 + 2];
+    return {mesh.x[a] + u * (mesh.x[b] - mesh.x[a]) + v * (mesh.x[c] - mesh.x[a]),
+            mesh.y[a] + u * (mesh.y[b] - mesh.y[a]) + v * (mesh.y[c] - mesh.y[a]),
+            mesh.z[a] + u * (mesh.z[b] - mesh.z[a]) + v * (mesh.z[c] - mesh.z[a])};
+}
+
+/// <summary>
+///     Optimizes the L meshes from the given json folder and times batches of random path requests through
+///     NavMeshPathService at doubling thread counts up to the given maximum, the hardware thread count by default.
+///     Every run is compared to the single thread paths. Returns a non zero exit code on any difference.
+///     Each mesh is optimized once as is and once decimated, and both answer the same requests, so the rows show
+///     what the triangle reduction gains in query time and costs in path length.
+/// </summary>
+int main(int argc, char *argv[]) {
+    const int requestCount = 20000, batchSize = 512, repeatCount = 5;
+
+    if (argc < 2) {
+        cout << "Usage: PathBenchmark <json folder> [max threads]\n";
+        return 1;
+    }
+
+    const fs::path folder = argv[1];
+    const int maxThreads = argc > 2 ? stoi(argv[2]) : ThreadPool::HardwareThreadCount();
+
+    vector<int> threadCounts = vector<int>();
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    int mismatches = 0;
+
+    cout << "Mesh, Decimated, Triangles, Threads, Queries/s, Speedup, Vs full mesh, Mean length\n";
+    for (int number = 1; number <= 5; number++) {
+        const string name = "L " + to_string(number);
+
+        NavMeshImport navMeshImport = NavMeshJsonReader::Load(folder / (name + ".json"));
+        const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0], navMeshImport.getCleanPoint()[1],
+                                           navMeshImport.getCleanPoint()[2]);
+
+        //Both meshes get the same requests, drawn from the full mesh.
+        vector<PathRequest> requests = vector<PathRequest>();
+        vector<double> fullRates = vector<double>();
+
+        for (const bool decimate: {false, true}) {
+            NavMeshData input = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+            NavMeshOptimized optimized = OptimizeNavMesh(cleanPoint, input, nullptr, 0, nullptr,
+                                                         HoleFillMode::Candidates, decimate);
+            const NavMeshData &mesh = optimized.getMesh();
+            NavMeshPathfinder pathfinder = NavMeshPathfinder(mesh);
+
+            if (!decimate) {
+                mt19937 random = mt19937(number);
+                for (int i = 0; i < requestCount; i++)
+                    requests.push_back({RandomPoint(mesh, random), RandomPoint(mesh, random)});
+            }
+
+            vector<PathResult> results = vector<PathResult>();
+            vector<vector<Vector3>> reference = vector<vector<Vector3>>(requestCount);
+            double singleRate = 0;
+
+            for (int t = 0; t < (int) threadCounts.size(); t++) {
+                const int threads = threadCounts[t];
+                ThreadPool pool = ThreadPool(threads);
+                NavMeshPathService service = NavMeshPathService(pathfinder, &pool);
+
+                double seconds = 0;
+                for (int repeat = 0; repeat < repeatCount; repeat++) {
+                    for (int first = 0; first < requestCount; first += batchSize) {
+                        const int count = min(batchSize, requestCount - first);
+
+                        auto timerStart = high_resolution_clock::now();
+                        service.FindPaths(requests.data() + first, count, results);
+                        seconds += duration<double>(high_resolution_clock::now() - timerStart).count();
+
+                        if (repeat != 0)
+                            continue;
+
+                        for (int i = 0; i < count; i++) {
+                            const Vector3 *points = service.PathPoints(results[i]);
+                            vector<Vector3> path = vector<Vector3>(points, points + results[i].count);
+
+                            if (threads == 1)
+                                reference[first + i] = path;
+                            else if (!(path.size() == reference[first + i].size() &&
+                                       equal(path.begin(), path.end(), reference[first + i].begin())))
+                                mismatches++;
+                        }
+                    }
+                }
+
+                const double rate = requestCount * (double) repeatCount / seconds;
+                if (threads == 1)
+                    singleRate = rate;
+                if (!decimate)
+                    fullRates.push_back(rate);
+
+                //Mean length of the paths found, to show what the coarser triangles cost in path quality.
+                double length = 0;
+                int found = 0;
+                for (const vector<Vector3> &path: reference) {
+                    for (int i = 1; i < (int) path.size(); i++)
+                        length += Vector3::Distance(path[i - 1], path[i]);
+                    found += !path.empty();
+                }
+
+                cout << name << ", " << (decimate ? "yes" : "no") << ", " << mesh.TriangleCount() << ", " << threads
+                     << ", " << (long long) rate << ", " << rate / singleRate << ", " << rate / fullRates[t] << ", "
+                     << length / max(found, 1) << "\n";
+            }
+        }
+    }
+
+    cout << "Mismatches: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include "Predicates.h"
+
+using namespace std;
+
+#pragma region Expansion arithmetic
+
+//An expansion is a sum of doubles ordered by increasing magnitude whose parts do not overlap, so its sign is the sign
+//of its last part. Zero parts are dropped, except that an expansion equal to zero keeps a single zero part.
+
+/// a + b == sum + error exactly.
+static inline void TwoSum(const double a, const double b, double &sum, double &error) {
+    sum = a + b;
+    const double bVirtual = sum - a, aVirtual = sum - bVirtual;
+    error = (a - aVirtual) + (b - bVirtual);
+}
+
+/// a * b == product + error exactly.
+static inline void TwoProduct(const double a, const double b, double &product, double &error) {
+    product = a * b;
+    error = fma(a, b, -product);
+}
+
+/// Expansion of a - b with one or two parts.
+static int Difference(const double a, const double b, double *h) {
+    const double difference = a - b;
+    const double bVirtual = a - difference, aVirtual = difference + bVirtual;
+    const double error = (a - aVirtual) + (bVirtual - b);
+
+    if (error == 0) {
+        h[0] = difference;
+        return 1;
+    }
+
+    h[0] = error;
+    h[1] = difference;
+    return 2;
+}
+
+/// h = e * b, h holds up to 2 * eLength parts.
+static int Scale(const int eLength, const double *e, const double b, double *h) {
+    int hLength = 0;
+    double q, error;
+    TwoProduct(e[0], b, q, error);
+    if (error != 0)
+        h[hLength++] = error;
+
+    for (int i = 1; i < eLength; i++) {
+        double product, productError, sum;
+        TwoProduct(e[i], b, product, productError);
+
+        TwoSum(q, productError, sum, error);
+        if (error != 0)
+            h[hLength++] = error;
+
+        TwoSum(product, sum, q, error);
+        if (error != 0)
+            h[hLength++] = error;
+    }
+
+    if (q != 0 || hLength == 0)
+        h[hLength++] = q;
+    return hLength;
+}
+
+/// h = e + f, h holds up to eLength + fLength parts and may not be e or f.
+static int Sum(const int eLength, const double *e, const int fLength, const double *f, double *h) {
+    int eIndex = 0, fIndex = 0, hLength = 0;
+
+    //Parts are added from small to large magnitude, merging both expansions.
+    auto next = [&]() {
+        if (fIndex == fLength || (eIndex < eLength && (f[fIndex] > e[eIndex]) == (f[fIndex] > -e[eIndex])))
+            return e[eIndex++];
+        return f[fIndex++];
+    };
+
+    double q = next();
+    while (eIndex < eLength || fIndex < fLength) {
+        double sum, error;
+        TwoSum(q, next(), sum, error);
+        q = sum;
+        if (error != 0)
+            h[hLength++] = error;
+    }
+
+    if (q != 0 || hLength == 0)
+        h[hLength++] = q;
+    return hLength;
+}
+
+/// h = e * f, h holds up to 2 * eLength * fLength parts and scratch as many plus 2 * eLength.
+static int Product(const int eLength, const double *e, const int fLength, const double *f, double *h,
+                   double *scratch) {
+    double *part = scratch, *sum = scratch + 2 * eLength;
+
+    int hLength = Scale(eLength, e, f[0], h);
+    for (int i = 1; i < fLength; i++) {
+        const int partLength = Scale(eLength, e, f[i], part);
+        hLength = Sum(hLength, h, partLength, part, sum);
+        copy(sum, sum + hLength, h);
+    }
+
+    return hLength;
+}
+
+/// h = x * y - z * w for expansions of at most two parts, h holds up to 16 parts.
+static int CrossProduct(const int xLength, const double *x, const int yLength, const double *y, const int zLength,
+                        const double *z, const int wLength, const double *w, double *h) {
+    double left[8], right[8], scratch[12];
+    const int leftLength = Product(xLength, x, yLength, y, left, scratch);
+    const int rightLength = Product(zLength, z, wLength, w, right, scratch);
+
+    for (int i = 0; i < rightLength; i++)
+        right[i] = -right[i];
+
+    return Sum(leftLength, left, rightLength, right, h);
+}
+
+#pragma endregion
+
+double Predicates::Orient2DExact(const double ax, const double ay, const double bx, const double by, const double cx,
+                                 const double cy) {
+    double acx[2], acy[2], bcx[2], bcy[2], det[16];
+    const int acxLength = Difference(ax, cx, acx), acyLength = Difference(ay, cy, acy),
+            bcxLength = Difference(bx, cx, bcx), bcyLength = Difference(by, cy, bcy);
+
+    const int detLength = CrossProduct(acxLength, acx, bcyLength, bcy, acyLength, acy, bcxLength, bcx, det);
+    return det[detLength - 1];
+}
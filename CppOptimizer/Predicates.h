@@ -0,0 +1,46 @@
+#ifndef CPPOPTIMIZER_PREDICATES_H
+#define CPPOPTIMIZER_PREDICATES_H
+
+#include <cmath>
+#include "Vector2.h"
+
+using namespace std;
+
+/// <summary>
+///     Orientation test in the XZ plane whose sign is always exact, after Shewchuk's adaptive predicates. The
+///     determinant is first evaluated in double along with a bound on its rounding error, and only when the result
+///     lies within that bound is it evaluated again with exact expansion arithmetic. Float coordinates convert to
+///     double exactly and their differences and products can not underflow or overflow there, so the bound holds
+///     for every input.
+/// </summary>
+class Predicates {
+public:
+    ///<summary>Half the distance from 1 to the next double.</summary>
+    static constexpr double epsilon = 1.0 / 9007199254740992.0;
+
+    ///<summary>Rounding error of the double Orient2D determinant, relative to its permanent.</summary>
+    static constexpr double orientBound = (3.0 + 16.0 * epsilon) * epsilon;
+
+    /// <returns>
+    ///     Positive when a, b and c are in counterclockwise order, negative when clockwise and zero when they are
+    ///     collinear. Only the sign is exact.
+    /// </returns>
+    static double Orient2D(const Vector2 &a, const Vector2 &b, const Vector2 &c);
+
+    static double Orient2DExact(double ax, double ay, double bx, double by, double cx, double cy);
+};
+
+inline double Predicates::Orient2D(const Vector2 &a, const Vector2 &b, const Vector2 &c) {
+    const double left = ((double) a.x - c.x) * ((double) b.y - c.y);
+    const double right = ((double) a.y - c.y) * ((double) b.x - c.x);
+    const double det = left - right;
+
+    //Both products are exactly zero only when a coordinate difference is, so a zero bound is exact as well.
+    if (fabs(det) >= orientBound * (fabs(left) + fabs(right)))
+        return det;
+
+    return Orient2DExact(a.x, a.y, b.x, b.y, c.x, c.y);
+}
+
+
+#endif //CPPOPTIMIZER_PREDICATES_H
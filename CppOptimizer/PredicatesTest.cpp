@@ -0,0 +1,145 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "Predicates.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void Check(const bool condition, const char *name) {
+    if (condition)
+        return;
+
+    cout << "Failed: " << name << "\n";
+    failures++;
+}
+
+static int Sign(const double value) {
+    return (value > 0) - (value < 0);
+}
+
+/// <summary>
+///     Sign of the orientation of points on the grid of the given step, evaluated in 128 bit integers.
+/// </summary>
+static int GridSign(const Vector2 &a, const Vector2 &b, const Vector2 &c, const double step) {
+    const __int128 ax = llround(a.x / step), ay = llround(a.y / step), bx = llround(b.x / step),
+            by = llround(b.y / step), cx = llround(c.x / step), cy = llround(c.y / step);
+    const __int128 det = (ax - cx) * (by - cy) - (ay - cy) * (bx - cx);
+    return (det > 0) - (det < 0);
+}
+
+/// <summary>
+///     The double evaluation Orient2D starts with, before its error bound is checked.
+/// </summary>
+static double NaiveOrient2D(const Vector2 &a, const Vector2 &b, const Vector2 &c) {
+    return ((double) a.x - c.x) * ((double) b.y - c.y) - ((double) a.y - c.y) * ((double) b.x - c.x);
+}
+
+/// <summary>
+///     True when the double evaluation is within its error bound, so Orient2D falls back to the exact evaluation.
+/// </summary>
+static bool Uncertain(const Vector2 &a, const Vector2 &b, const Vector2 &c) {
+    const double left = ((double) a.x - c.x) * ((double) b.y - c.y);
+    const double right = ((double) a.y - c.y) * ((double) b.x - c.x);
+    return fabs(left - right) < Predicates::orientBound * (fabs(left) + fabs(right));
+}
+
+/// <summary>
+///     Checks the sign of Predicates::Orient2D on exactly collinear points, on points a grid step off a line, on
+///     huge and tiny coordinates, and on both sides of the split between the double filter and the exact
+///     evaluation. Returns a non zero exit code on any failure.
+/// </summary>
+int main() {
+    const int tripleCount = 200000;
+
+#pragma region Exactly and nearly collinear points
+
+    //Grid coordinates are exact floats, so the 128 bit determinant is an exact reference.
+    const double step = 1.0 / 1024.0;
+    mt19937 random = mt19937(1);
+    uniform_int_distribution<int> cell = uniform_int_distribution<int>(-(1 << 20), 1 << 20),
+            direction = uniform_int_distribution<int>(-64, 64), multiple = uniform_int_distribution<int>(-200, 200),
+            offset = uniform_int_distribution<int>(-1, 1);
+
+    int collinearWrong = 0, nearWrong = 0, filtered = 0, exact = 0;
+    for (int i = 0; i < tripleCount; i++) {
+        const int ax = cell(random), ay = cell(random), dx = direction(random), dy = direction(random),
+                m = multiple(random), n = multiple(random);
+
+        const Vector2 a = Vector2((float) (ax * step), (float) (ay * step)),
+                b = Vector2((float) ((ax + m * dx) * step), (float) ((ay + m * dy) * step)),
+                c = Vector2((float) ((ax + n * dx) * step), (float) ((ay + n * dy) * step));
+        collinearWrong += Predicates::Orient2D(a, b, c) != 0;
+
+        const Vector2 near = Vector2(c.x + (float) (offset(random) * step), c.y + (float) (offset(random) * step));
+        const double orientation = Predicates::Orient2D(a, b, near);
+        nearWrong += Sign(orientation) != GridSign(a, b, near, step);
+
+        if (Uncertain(a, b, near))
+            exact++;
+        else
+            filtered++;
+    }
+
+    Check(collinearWrong == 0, "exactly collinear points give zero");
+    Check(nearWrong == 0, "points a grid step off a line get the exact sign");
+    Check(filtered > 0 && exact > 0, "near collinear points run both the filter and the exact evaluation");
+
+#pragma endregion
+
+#pragma region Huge and tiny coordinates
+
+    //For b and c on the line y = x the determinant is (b.x - c.x) * (a.x - a.y), whatever the magnitudes.
+    const float huge = ldexp(1.0f, 100), tiny = ldexp(1.0f, -130), smallest = ldexp(1.0f, -149);
+
+    Check(Predicates::Orient2D(Vector2(huge, huge), Vector2(2 * huge, 2 * huge), Vector2(3 * huge, 3 * huge)) == 0,
+          "huge collinear points give zero");
+    Check(Predicates::Orient2D(Vector2(tiny, tiny), Vector2(2 * tiny, 2 * tiny), Vector2(3 * tiny, 3 * tiny)) == 0,
+          "tiny collinear points give zero");
+    Check(Predicates::Orient2D(Vector2(tiny, tiny + smallest), Vector2(2 * tiny, 2 * tiny), Vector2(tiny, tiny)) < 0,
+          "a tiny point a denormal step off the line gets its sign");
+    Check(Predicates::Orient2D(Vector2(huge + ldexp(huge, -23), huge), Vector2(huge, huge),
+                               Vector2(-huge, -huge)) > 0,
+          "a huge point an ulp off the line gets its sign");
+
+    //Differences between huge and tiny coordinates round in double, so the filter sees two equal products.
+    const Vector2 below = Vector2(tiny + smallest, tiny), above = Vector2(tiny, tiny + smallest),
+            lineB = Vector2(2 * huge, 2 * huge), lineC = Vector2(huge, huge);
+
+    Check(NaiveOrient2D(below, lineB, lineC) == 0 && Uncertain(below, lineB, lineC),
+          "mixed magnitudes are left to the exact evaluation");
+    Check(Predicates::Orient2D(below, lineB, lineC) > 0, "a tiny point below a line of huge points gets its sign");
+    Check(Predicates::Orient2D(above, lineB, lineC) < 0, "a tiny point above a line of huge points gets its sign");
+    Check(Predicates::Orient2D(lineB, lineC, below) > 0 && Predicates::Orient2D(lineC, lineB, below) < 0,
+          "rotating the points keeps the sign and swapping two flips it");
+
+#pragma endregion
+
+#pragma region Filter and exact split
+
+    //Away from the line the filter decides and returns the double determinant itself.
+    const Vector2 a = Vector2(0.1f, 0.2f), b = Vector2(3.7f, -1.3f), c = Vector2(-2.9f, 5.3f);
+    Check(!Uncertain(a, b, c) && Predicates::Orient2D(a, b, c) == NaiveOrient2D(a, b, c),
+          "the filter returns the double determinant when it is certain");
+
+    //The exact evaluation agrees in sign with the filter wherever the filter is certain.
+    uniform_real_distribution<float> position = uniform_real_distribution<float>(-1000.0f, 1000.0f);
+    int disagreements = 0;
+    for (int i = 0; i < tripleCount; i++) {
+        const Vector2 p = Vector2(position(random), position(random)), q = Vector2(position(random), position(random)),
+                r = Vector2(position(random), position(random));
+
+        disagreements += Sign(Predicates::Orient2D(p, q, r)) != Sign(Predicates::Orient2DExact(p.x, p.y, q.x, q.y,
+                                                                                              r.x, r.y));
+    }
+    Check(disagreements == 0, "the filter and the exact evaluation agree on random points");
+
+#pragma endregion
+
+    cout << "Near collinear triples: " << filtered << " filtered, " << exact << " exact\n";
+    cout << (failures == 0 ? "All checks passed" : "Some checks failed") << "\n";
+    return failures == 0 ? 0 : 1;
+}
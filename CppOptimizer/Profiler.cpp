@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "Profiler.h"
+
+using json = nlohmann::json;
+
+using namespace std;
+
+struct ProfilerBuffer {
+    int thread = 0;
+    vector<Profiler::Event> events;
+};
+
+static mutex buffersMutex;
+static vector<unique_ptr<ProfilerBuffer>> buffers;
+
+static thread_local ProfilerBuffer *localBuffer = nullptr;
+static thread_local long long localAllocations = 0, localAllocatedBytes = 0;
+//Set while the profiler itself allocates, so its own buffers are not counted.
+static thread_local bool localRecording = false;
+
+#ifdef CPPOPTIMIZER_PROFILE
+
+void *operator new(size_t size) {
+    if (!localRecording) {
+        localAllocations++;
+        localAllocatedBytes += (long long) size;
+    }
+
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        throw bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+//Both sides of the replacement use malloc and free, which GCC can not tell once new is inlined into a caller.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete[](void *p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    operator delete(p);
+}
+
+//The default pmr resource allocates through the aligned forms. The block is over-allocated and the pointer
+//returned by malloc is stored right before the aligned address.
+void *operator new(size_t size, align_val_t alignment) {
+    const size_t align = max((size_t) alignment, sizeof(void *));
+    void *p = operator new(size + align);
+    void *aligned = (void *) (((uintptr_t) p + sizeof(void *) + align - 1) & ~(uintptr_t) (align - 1));
+    ((void **) aligned)[-1] = p;
+    return aligned;
+}
+
+void *operator new[](size_t size, align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void *p, align_val_t) noexcept {
+    if (p != nullptr)
+        operator delete(((void **) p)[-1]);
+}
+
+void operator delete[](void *p, align_val_t alignment) noexcept {
+    operator delete(p, alignment);
+}
+
+void operator delete(void *p, size_t, align_val_t alignment) noexcept {
+    operator delete(p, alignment);
+}
+
+void operator delete[](void *p, size_t, align_val_t alignment) noexcept {
+    operator delete(p, alignment);
+}
+
+#endif
+
+long long Profiler::Now() {
+    static const chrono::steady_clock::time_point epoch = chrono::steady_clock::now();
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::Record(const Event &event) {
+    localRecording = true;
+
+    if (localBuffer == nullptr) {
+        lock_guard<mutex> lock(buffersMutex);
+        buffers.push_back(make_unique<ProfilerBuffer>());
+        localBuffer = buffers.back().get();
+        localBuffer->thread = (int) buffers.size() - 1;
+    }
+
+    localBuffer->events.push_back(event);
+    localBuffer->events.back().thread = localBuffer->thread;
+
+    localRecording = false;
+}
+
+void Profiler::Count(const char *name, const long long value) {
+    Event event = Event();
+    event.name = name;
+    event.counter = true;
+    event.start = Now();
+    event.value = value;
+    Record(event);
+}
+
+long long Profiler::AllocationCount() {
+    return localAllocations;
+}
+
+long long Profiler::AllocatedBytes() {
+    return localAllocatedBytes;
+}
+
+vector<Profiler::Event> Profiler::Events() {
+    vector<Event> events = vector<Event>();
+
+    lock_guard<mutex> lock(buffersMutex);
+    for (const unique_ptr<ProfilerBuffer> &buffer: buffers)
+        events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+
+    //Enclosing scopes before the scopes they contain.
+    stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) {
+        return a.start != b.start ? a.start < b.start : a.duration > b.duration;
+    });
+    return events;
+}
+
+void Profiler::Reset() {
+    lock_guard<mutex> lock(buffersMutex);
+    for (const unique_ptr<ProfilerBuffer> &buffer: buffers)
+        buffer->events.clear();
+}
+
+void Profiler::WriteChromeTrace(const filesystem::path &fileName) {
+    json traceEvents = json::array();
+
+    for (const Event &event: Events()) {
+        json e = json();
+        e["name"] = event.name;
+        e["pid"] = 1;
+        e["tid"] = event.thread;
+        e["ts"] = (double) event.start / 1000.0;
+
+        if (event.counter) {
+            e["ph"] = "C";
+            e["args"] = {{"value", event.value}};
+        }
+        else {
+            e["ph"] = "X";
+            e["dur"] = (double) event.duration / 1000.0;
+            e["args"] = {{"allocations", event.allocations}, {"allocatedBytes", event.allocatedBytes}};
+        }
+
+        traceEvents.push_back(e);
+    }
+
+    ofstream file(fileName);
+    if (!file)
+        throw runtime_error("could not write " + fileName.string());
+    file << json({{"traceEvents", traceEvents}, {"displayTimeUnit", "ms"}});
+}
+
+void Profiler::WriteStageCsv(const filesystem::path &fileName) {
+    struct Row {
+        string name;
+        bool counter = false;
+        long long calls = 0, total = 0, max = 0, allocations = 0, allocatedBytes = 0;
+    };
+
+    vector<Row> rows = vector<Row>();
+    map<string, int> rowByName = map<string, int>();
+
+    for (const Event &event: Events()) {
+        auto inserted = rowByName.insert({event.name, (int) rows.size()});
+        if (inserted.second) {
+            rows.emplace_back();
+            rows.back().name = event.name;
+            rows.back().counter = event.counter;
+        }
+
+        Row &row = rows[inserted.first->second];
+        const long long amount = event.counter ? event.value : event.duration;
+        row.calls++;
+        row.total += amount;
+        row.max = row.calls == 1 ? amount : max(row.max, amount);
+        row.allocations += event.allocations;
+        row.allocatedBytes += event.allocatedBytes;
+    }
+
+    ofstream file(fileName);
+    if (!file)
+        throw runtime_error("could not write " + fileName.string());
+
+    file << "Name,Type,Calls,Total,Mean,Max,Allocations,AllocatedBytes\n";
+    for (const Row &row: rows) {
+        const double scale = row.counter ? 1.0 : 1e-6;
+        file << row.name << "," << (row.counter ? "counter" : "scope") << "," << row.calls << ","
+             << (double) row.total * scale << "," << (double) row.total * scale / (double) row.calls << ","
+             << (double) row.max * scale << "," << row.allocations << "," << row.allocatedBytes << "\n";
+    }
+}
+
+ProfileScope::ProfileScope(const char *name) : name_(name) {
+    allocations_ = Profiler::AllocationCount();
+    allocatedBytes_ = Profiler::AllocatedBytes();
+    start_ = Profiler::Now();
+}
+
+ProfileScope::~ProfileScope() {
+    Profiler::Event event = Profiler::Event();
+    event.name = name_;
+    event.start = start_;
+    event.duration = Profiler::Now() - start_;
+    event.allocations = Profiler::AllocationCount() - allocations_;
+    event.allocatedBytes = Profiler::AllocatedBytes() - allocatedBytes_;
+    Profiler::Record(event);
+}
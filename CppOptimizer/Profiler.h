@@ -0,0 +1,91 @@
+#ifndef CPPOPTIMIZER_PROFILER_H
+#define CPPOPTIMIZER_PROFILER_H
+
+#include <filesystem>
+#include <vector>
+
+using namespace std;
+
+/// <summary>
+///     Scoped stage timers and counters for the optimizer, recorded per thread without locking. Use the
+///     PROFILE_SCOPE and PROFILE_COUNT macros, which compile to nothing unless CPPOPTIMIZER_PROFILE is defined.
+///     When it is, every operator new is counted as well, and every scope reports the allocations made on its
+///     thread while it was open, nested scopes included.
+/// </summary>
+class Profiler {
+public:
+    struct Event {
+        const char *name;
+        int thread;
+        bool counter;
+        ///<summary>Nanoseconds since the first event.</summary>
+        long long start, duration;
+        long long value, allocations, allocatedBytes;
+    };
+
+#ifdef CPPOPTIMIZER_PROFILE
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    static long long Now();
+
+    static void Record(const Event &event);
+
+    static void Count(const char *name, long long value);
+
+    ///<summary>Allocations made on the calling thread so far, always 0 when profiling is compiled out.</summary>
+    static long long AllocationCount();
+
+    static long long AllocatedBytes();
+
+    /// <summary>
+    ///     Events of every thread ordered by their start. Must not run while other threads are recording.
+    /// </summary>
+    static vector<Event> Events();
+
+    /// <summary>
+    ///     Drops every recorded event. Must not run while other threads are recording.
+    /// </summary>
+    static void Reset();
+
+    /// <summary>
+    ///     Writes the events in the Chrome trace event format, for chrome://tracing or Perfetto.
+    /// </summary>
+    static void WriteChromeTrace(const filesystem::path &fileName);
+
+    /// <summary>
+    ///     Writes one row per scope or counter name in order of first appearance. Times are in milliseconds, counter
+    ///     rows sum their values.
+    /// </summary>
+    static void WriteStageCsv(const filesystem::path &fileName);
+};
+
+class ProfileScope {
+private:
+    const char *name_;
+    long long start_, allocations_, allocatedBytes_;
+
+public:
+    explicit ProfileScope(const char *name);
+
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#ifdef CPPOPTIMIZER_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_COUNT(name, value) Profiler::Count(name, (long long) (value))
+#else
+#define PROFILE_SCOPE(name) ((void) 0)
+#define PROFILE_COUNT(name, value) ((void) 0)
+#endif
+
+
+#endif //CPPOPTIMIZER_PROFILER_H
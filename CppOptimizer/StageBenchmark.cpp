@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "EdgeAdjacency.h"
+#include "GeometryPolicy.h"
+#include "HoleFiller.h"
+#include "MeshDecimator.h"
+#include "NavMeshJsonReader.h"
+#include "NavMeshOptimizer.h"
+#include "VertexWeld.h"
+
+using json = nlohmann::json;
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+struct StageStatistics {
+    string mesh, stage;
+    int samples = 0;
+    double mean = 0, median = 0, p99 = 0, min = 0, max = 0;
+};
+
+/// <summary>
+///     Runs prepare untimed before every sample and times only run, in nanoseconds. After the warmup runs, samples
+///     are taken until both the minimum sample count and the minimum total time are reached, or the maximum sample
+///     count is.
+/// </summary>
+static StageStatistics Measure(const string &mesh, const string &stage, const function<void()> &prepare,
+                               const function<void()> &run, const int warmupCount, const int minSamples,
+                               const double minSeconds) {
+    const int maxSamples = 100000;
+
+    for (int i = 0; i < warmupCount; i++) {
+        prepare();
+        run();
+    }
+
+    vector<double> samples = vector<double>();
+    double total = 0;
+    while ((int) samples.size() < maxSamples && ((int) samples.size() < minSamples || total < minSeconds * 1e9)) {
+        prepare();
+
+        auto timerStart = steady_clock::now();
+        run();
+        const double time = (double) duration_cast<nanoseconds>(steady_clock::now() - timerStart).count();
+
+        samples.push_back(time);
+        total += time;
+    }
+
+    sort(samples.begin(), samples.end());
+
+    StageStatistics statistics = StageStatistics();
+    statistics.mesh = mesh;
+    statistics.stage = stage;
+    statistics.samples = (int) samples.size();
+    statistics.mean = total / (double) samples.size();
+    statistics.median = samples.size() % 2 == 1
+                        ? samples[samples.size() / 2]
+                        : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2.0;
+    statistics.p99 = samples[min(samples.size() - 1, (size_t) ceil(0.99 * (double) samples.size()) - 1)];
+    statistics.min = samples.front();
+    statistics.max = samples.back();
+    return statistics;
+}
+
+static void WriteCsv(ostream &out, const vector<StageStatistics> &results) {
+    out << "mesh,stage,samples,mean_ns,median_ns,p99_ns,min_ns,max_ns\n";
+    out << fixed;
+    out.precision(0);
+    for (const StageStatistics &s: results)
+        out << s.mesh << "," << s.stage << "," << s.samples << "," << s.mean << "," << s.median << "," << s.p99
+            << "," << s.min << "," << s.max << "\n";
+}
+
+static void WriteJson(ostream &out, const vector<StageStatistics> &results) {
+    json list = json::array();
+    for (const StageStatistics &s: results)
+        list.push_back({{"mesh", s.mesh}, {"stage", s.stage}, {"samples", s.samples}, {"mean_ns", s.mean},
+                        {"median_ns", s.median}, {"p99_ns", s.p99}, {"min_ns", s.min}, {"max_ns", s.max}});
+
+    out << json({{"unit", "ns"}, {"results", list}}).dump(2) << "\n";
+}
+
+/// <summary>
+///     Times every stage of OptimizeNavMesh on its own, and the whole pipeline with and without an arena, for the
+///     S, M and L meshes in the given json folder. Each stage starts from the state the stages before it leave,
+///     prepared outside the timed region. Results go to standard output or the --out file, as csv or, with --json,
+///     as json.
+///     Usage: StageBenchmark <json folder> [--out file] [--json] [--warmup N] [--samples N] [--min-time seconds]
+/// </summary>
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cout << "Usage: StageBenchmark <json folder> [--out file] [--json] [--warmup N] [--samples N] "
+                "[--min-time seconds]\n";
+        return 1;
+    }
+
+    const fs::path folder = argv[1];
+    fs::path output = fs::path();
+    bool asJson = false;
+    int warmupCount = 3, minSamples = 30;
+    double minSeconds = 0.2;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc)
+            output = argv[++i];
+        else if (arg == "--json")
+            asJson = true;
+        else if (arg == "--warmup" && i + 1 < argc)
+            warmupCount = stoi(argv[++i]);
+        else if (arg == "--samples" && i + 1 < argc)
+            minSamples = max(1, stoi(argv[++i]));
+        else if (arg == "--min-time" && i + 1 < argc)
+            minSeconds = stod(argv[++i]);
+    }
+
+    const float groupSize = DefaultPolicy::groupSize, overlapCheckDistance = DefaultPolicy::overlapCheckDistance;
+    const size_t arenaBytes = 32 << 20;
+
+    //The arena case reuses one buffer for the temporaries of every run, released before each run.
+    vector<char> arenaBuffer = vector<char>(arenaBytes);
+    pmr::monotonic_buffer_resource arena = pmr::monotonic_buffer_resource(arenaBuffer.data(), arenaBuffer.size());
+
+    vector<StageStatistics> results = vector<StageStatistics>();
+    for (const string letter: {"S", "M", "L"}) {
+        for (int number = 1; number <= 5; number++) {
+            const string name = letter + " " + to_string(number);
+            const fs::path file = folder / (name + ".json");
+            cerr << "Benchmarking " << name << "\n";
+
+            NavMeshImport navMeshImport = NavMeshJsonReader::Load(file);
+            const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0], navMeshImport.getCleanPoint()[1],
+                                               navMeshImport.getCleanPoint()[2]);
+
+            //The input of every stage, built once by running the stages before it.
+            const NavMeshData input = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+
+            NavMeshData welded = input;
+            VertexWeld::Weld(welded, overlapCheckDistance);
+
+            NavMeshData setup = welded;
+            pmr::map<int, pmr::vector<int>> trianglesByVertexId = pmr::map<int, pmr::vector<int>>();
+            SetupNavTriangles(setup, trianglesByVertexId);
+
+            NavMeshData linked = setup;
+            EdgeAdjacency adjacency = EdgeAdjacency();
+            adjacency.Build(linked.indices, linked.VertexCount());
+            adjacency.SetupNeighbors(linked.triangles);
+
+            vector<int> islandSizes = vector<int>(), keptIslands = vector<int>();
+            const vector<int> connected = KeepConnected(cleanPoint, linked, trianglesByVertexId, 0, islandSizes,
+                                                        keptIslands);
+
+            const NavMeshData extracted = linked.Extract(connected);
+            NavMeshData filled = extracted;
+            HoleFiller::FillHoles(filled, groupSize);
+
+            NavMeshData final = filled;
+            pmr::map<int, pmr::vector<int>> finalTrianglesByVertexId = pmr::map<int, pmr::vector<int>>();
+            SetupNavTriangles(final, finalTrianglesByVertexId);
+            adjacency.Build(final.indices, final.VertexCount());
+            adjacency.SetupNeighbors(final.triangles);
+            for (NavMeshTriangle &triangle: final.triangles)
+                triangle.SetBorderWidth(final);
+
+            NavMeshData mesh = NavMeshData();
+            pmr::map<int, pmr::vector<int>> lookup = pmr::map<int, pmr::vector<int>>();
+            NavMeshOptimized optimized = NavMeshOptimized();
+
+            auto measure = [&](const string &stage, const function<void()> &prepare, const function<void()> &run) {
+                results.push_back(Measure(name, stage, prepare, run, warmupCount, minSamples, minSeconds));
+            };
+
+            measure("Load", [] {}, [&] {
+                NavMeshImport loaded = NavMeshJsonReader::Load(file);
+            });
+            measure("CheckOverlap", [&] { mesh = input; }, [&] {
+                VertexWeld::Weld(mesh, overlapCheckDistance);
+            });
+            measure("SetupNavTriangles", [&] {
+                mesh = welded;
+                lookup.clear();
+            }, [&] {
+                SetupNavTriangles(mesh, lookup);
+            });
+            measure("SetupNeighbors", [&] { mesh = setup; }, [&] {
+                EdgeAdjacency edges = EdgeAdjacency();
+                edges.Build(mesh.indices, mesh.VertexCount());
+                edges.SetupNeighbors(mesh.triangles);
+            });
+            measure("FloodFill", [] {}, [&] {
+                vector<int> sizes = vector<int>(), kept = vector<int>();
+                KeepConnected(cleanPoint, linked, trianglesByVertexId, 0, sizes, kept);
+            });
+            measure("FillHoles", [&] { mesh = extracted; }, [&] {
+                HoleFiller::FillHoles(mesh, groupSize);
+            });
+            measure("FillHoleLoops", [&] { mesh = extracted; }, [&] {
+                HoleFiller::FillHoleLoops(mesh, overlapCheckDistance);
+            });
+            measure("Decimate", [&] { mesh = filled; }, [&] {
+                MeshDecimator::Decimate(mesh, DefaultPolicy::decimationError);
+            });
+            measure("SetValues", [&] { mesh = final; }, [&] {
+                optimized.SetValues(mesh, groupSize);
+            });
+            measure("OptimizeNavMesh", [&] { mesh = input; }, [&] {
+                NavMeshOptimized result = OptimizeNavMesh(cleanPoint, mesh, nullptr);
+            });
+            measure("OptimizeNavMeshArena", [&] {
+                mesh = input;
+                arena.release();
+            }, [&] {
+                NavMeshOptimized result = OptimizeNavMesh(cleanPoint, mesh, nullptr, 0, &arena);
+            });
+        }
+    }
+
+    if (output.empty()) {
+        if (asJson)
+            WriteJson(cout, results);
+        else
+            WriteCsv(cout, results);
+        return 0;
+    }
+
+    ofstream file = ofstream(output);
+    if (!file) {
+        cerr << "Can not write " << output << "\n";
+        return 1;
+    }
+
+    if (asJson)
+        WriteJson(file, results);
+    else
+        WriteCsv(file, results);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <memory>
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0)
+        threadCount = HardwareThreadCount();
+
+    running_ = 0;
+    stopping_ = false;
+
+    for (int i = 1; i < threadCount; i++)
+        threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    taskAvailable_.notify_all();
+
+    for (thread &t: threads_)
+        t.join();
+}
+
+int ThreadPool::ThreadCount() const {
+    return (int) threads_.size() + 1;
+}
+
+void ThreadPool::WorkerLoop(const int worker) {
+    while (true) {
+        function<void(int)> task;
+
+        {
+            unique_lock<mutex> lock(mutex_);
+            taskAvailable_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            running_++;
+        }
+
+        task(worker);
+
+        {
+            lock_guard<mutex> lock(mutex_);
+            running_--;
+            if (running_ == 0 && tasks_.empty())
+                tasksDone_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::Submit(function<void(int worker)> task) {
+    if (threads_.empty()) {
+        task(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    taskAvailable_.notify_one();
+}
+
+void ThreadPool::Wait() {
+    unique_lock<mutex> lock(mutex_);
+    tasksDone_.wait(lock, [this] { return running_ == 0 && tasks_.empty(); });
+}
+
+/// <summary>
+///     Shared between the caller and the helper tasks of one ParallelFor. Helpers that start after every chunk has
+///     been claimed return without touching the body, so the caller only waits for chunks, never for helpers.
+/// </summary>
+struct ParallelForState {
+    function<void(int, int, int)> body;
+    int count, grain;
+    atomic<int> next, done;
+    mutex doneMutex;
+    condition_variable allDone;
+};
+
+static void ClaimChunks(ParallelForState &state, const int worker) {
+    while (true) {
+        int begin = state.next.fetch_add(state.grain);
+        if (begin >= state.count)
+            return;
+
+        int end = min(begin + state.grain, state.count);
+        state.body(begin, end, worker);
+
+        if (state.done.fetch_add(end - begin) + (end - begin) == state.count) {
+            lock_guard<mutex> lock(state.doneMutex);
+            state.allDone.notify_all();
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(ThreadPool *pool, const int count, int grain,
+                             const function<void(int begin, int end, int worker)> &body) {
+    if (count <= 0)
+        return;
+
+    if (grain < 1)
+        grain = 1;
+
+    if (pool == nullptr || pool->ThreadCount() == 1 || count <= grain) {
+        body(0, count, 0);
+        return;
+    }
+
+    shared_ptr<ParallelForState> state = make_shared<ParallelForState>();
+    state->body = body;
+    state->count = count;
+    state->grain = grain;
+    state->next = 0;
+    state->done = 0;
+
+    const int helpers = min(pool->ThreadCount() - 1, (count + grain - 1) / grain - 1);
+    for (int i = 0; i < helpers; i++)
+        pool->Submit([state](int worker) { ClaimChunks(*state, worker); });
+
+    ClaimChunks(*state, 0);
+
+    unique_lock<mutex> lock(state->doneMutex);
+    state->allDone.wait(lock, [&state] { return state->done.load() == state->count; });
+}
+
+int ThreadPool::HardwareThreadCount() {
+    int count = (int) thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
@@ -0,0 +1,62 @@
+#ifndef CPPOPTIMIZER_THREADPOOL_H
+#define CPPOPTIMIZER_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/// <summary>
+///     Fixed set of worker threads.
+///     Submitted tasks go to a shared queue. ParallelFor splits a range into chunks that idle threads claim one at a
+///     time, so threads that finish early take over the remaining work, and the calling thread works along.
+///     Workers are numbered 1 to ThreadCount() - 1, the calling thread of ParallelFor is worker 0.
+/// </summary>
+class ThreadPool {
+private:
+    vector<thread> threads_;
+    deque<function<void(int)>> tasks_;
+
+    mutex mutex_;
+    condition_variable taskAvailable_, tasksDone_;
+    int running_;
+    bool stopping_;
+
+    void WorkerLoop(int worker);
+
+public:
+    /// <param name="threadCount">Total thread count including the caller, 0 uses the hardware thread count.</param>
+    explicit ThreadPool(int threadCount);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int ThreadCount() const;
+
+    void Submit(function<void(int worker)> task);
+
+    /// <summary>
+    ///     Blocks until every submitted task has finished.
+    /// </summary>
+    void Wait();
+
+    /// <summary>
+    ///     Runs body(begin, end, worker) over [0, count) in chunks of at most grain items and blocks until done.
+    ///     Runs inline when the pool is null or has a single thread.
+    /// </summary>
+    static void ParallelFor(ThreadPool *pool, int count, int grain,
+                            const function<void(int begin, int end, int worker)> &body);
+
+    static int HardwareThreadCount();
+};
+
+
+#endif //CPPOPTIMIZER_THREADPOOL_H
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "NavMeshJsonReader.h"
+#include "NavMeshOptimizer.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace fs = filesystem;
+
+/// <summary>
+///     Times OptimizeNavMeshTiled on the L meshes from the given json folder for a range of tile sizes at doubling
+///     thread counts up to the given maximum, the hardware thread count by default. The untiled OptimizeNavMesh on
+///     a single thread is the baseline for the speedup, and the triangle count shows what the seams cost.
+/// </summary>
+int main(int argc, char *argv[]) {
+    const int repeatCount = 5;
+    const vector<float> tileSizes = {400.0f, 200.0f, 100.0f, 50.0f, 25.0f};
+
+    if (argc < 2) {
+        cout << "Usage: TileBenchmark <json folder> [max threads]\n";
+        return 1;
+    }
+
+    const fs::path folder = argv[1];
+    const int maxThreads = argc > 2 ? stoi(argv[2]) : ThreadPool::HardwareThreadCount();
+
+    vector<int> threadCounts = vector<int>();
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    cout << "Mesh, Tile size, Threads, Milliseconds, Speedup, Triangles\n";
+    for (int number = 1; number <= 5; number++) {
+        const string name = "L " + to_string(number);
+
+        NavMeshImport navMeshImport = NavMeshJsonReader::Load(folder / (name + ".json"));
+        const NavMeshData input = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+        const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0], navMeshImport.getCleanPoint()[1],
+                                           navMeshImport.getCleanPoint()[2]);
+
+        double baseline = 0;
+        int triangles = 0;
+        for (int repeat = 0; repeat < repeatCount; repeat++) {
+            NavMeshData mesh = input;
+
+            auto timerStart = high_resolution_clock::now();
+            NavMeshOptimized optimized = OptimizeNavMesh(cleanPoint, mesh, nullptr);
+            baseline += duration<double, milli>(high_resolution_clock::now() - timerStart).count();
+            triangles = optimized.getMesh().TriangleCount();
+        }
+        baseline /= repeatCount;
+
+        cout << name << ", untiled, 1, " << baseline << ", 1, " << triangles << "\n";
+
+        for (const float tileSize: tileSizes) {
+            for (const int threads: threadCounts) {
+                ThreadPool pool = ThreadPool(threads);
+
+                double milliseconds = 0;
+                for (int repeat = 0; repeat < repeatCount; repeat++) {
+                    auto timerStart = high_resolution_clock::now();
+                    NavMeshOptimized optimized = OptimizeNavMeshTiled(cleanPoint, input, tileSize, &pool);
+                    milliseconds += duration<double, milli>(high_resolution_clock::now() - timerStart).count();
+                    triangles = optimized.getMesh().TriangleCount();
+                }
+                milliseconds /= repeatCount;
+
+                cout << name << ", " << tileSize << ", " << threads << ", " << milliseconds << ", "
+                     << baseline / milliseconds << ", " << triangles << "\n";
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,438 @@
+#include <algorithm>
+#include <cmath>
+#include "TriangleLocator.h"
+#include "GeometryPolicy.h"
+#include "MathC.h"
+#include "NavMeshBinary.h"
+
+using namespace std;
+
+TriangleLocator::TriangleLocator() {
+    cellSize_ = 1.0f;
+    originX_ = 0;
+    originZ_ = 0;
+    width_ = 0;
+    height_ = 0;
+}
+
+void TriangleLocator::Build(const NavMeshData &mesh, const float cellSize) {
+    cellStart_.clear();
+    cellItems_.clear();
+    width_ = 0;
+    height_ = 0;
+
+    const int triangleCount = mesh.TriangleCount();
+    if (triangleCount == 0)
+        return;
+
+    const vector<int> &indices = mesh.indices;
+    float minX = mesh.x[indices[0]], minZ = mesh.z[indices[0]], maxX = minX, maxZ = minZ;
+    for (const int i: indices) {
+        minX = MathC::Min(minX, mesh.x[i]);
+        minZ = MathC::Min(minZ, mesh.z[i]);
+        maxX = MathC::Max(maxX, mesh.x[i]);
+        maxZ = MathC::Max(maxZ, mesh.z[i]);
+    }
+
+    const long long maxCells = 4LL * triangleCount + 1024;
+    cellSize_ = cellSize;
+    while (true) {
+        originX_ = (int) floor(minX / cellSize_);
+        originZ_ = (int) floor(minZ / cellSize_);
+        width_ = (int) floor(maxX / cellSize_) - originX_ + 1;
+        height_ = (int) floor(maxZ / cellSize_) - originZ_ + 1;
+
+        if ((long long) width_ * height_ <= maxCells)
+            break;
+
+        cellSize_ *= 2.0f;
+    }
+
+    //Two passes over the same overlap tests, the first counts the triangles per cell, the second fills them in.
+    cellStart_.assign(width_ * height_ + 1, 0);
+    vector<int> cells = vector<int>();
+    for (int pass = 0; pass < 2; pass++) {
+        vector<int> fill = vector<int>();
+        if (pass == 1) {
+            for (int c = 0; c < width_ * height_; c++)
+                cellStart_[c + 1] += cellStart_[c];
+            cellItems_.resize(cellStart_[width_ * height_]);
+            fill.assign(cellStart_.begin(), cellStart_.end() - 1);
+        }
+
+        for (int t = 0; t < triangleCount; t++) {
+            OverlappedCells(mesh, t, cells);
+
+            for (const int cell: cells) {
+                if (pass == 0)
+                    cellStart_[cell + 1]++;
+                else
+                    cellItems_[fill[cell]++] = t;
+            }
+        }
+    }
+}
+
+void TriangleLocator::Load(const NavMeshBinaryView &view) {
+    const NavMeshBinaryHeader &header = view.Header();
+    cellSize_ = header.bucketCellSize;
+    originX_ = header.bucketOriginX;
+    originZ_ = header.bucketOriginZ;
+    width_ = header.bucketWidth;
+    height_ = header.bucketHeight;
+
+    cellStart_.assign(view.BucketStart(), view.BucketStart() + width_ * height_ + 1);
+    cellItems_.assign(view.BucketItems(), view.BucketItems() + header.bucketItemCount);
+}
+
+void TriangleLocator::Update(const NavMeshData &mesh, const float cellSize, const vector<int> &triangleRemap,
+                             const int firstNewTriangle) {
+    const int triangleCount = mesh.TriangleCount();
+    if (width_ == 0) {
+        Build(mesh, cellSize);
+        return;
+    }
+
+    const vector<int> &indices = mesh.indices;
+    for (int i = firstNewTriangle * 3; i < triangleCount * 3; i++) {
+        const float cx = floor(mesh.x[indices[i]] / cellSize_) - (float) originX_,
+                cz = floor(mesh.z[indices[i]] / cellSize_) - (float) originZ_;
+
+        if (cx < 0 || cz < 0 || cx >= (float) width_ || cz >= (float) height_) {
+            Build(mesh, cellSize);
+            return;
+        }
+    }
+
+    //Kept triangles are copied over renumbered, only the new ones are tested against the cells. Both keep the
+    //triangles of a cell in ascending order, as the kept ones keep their relative order and the new ones come last.
+    const int cellCount = width_ * height_;
+    vector<int> start = vector<int>(cellCount + 1, 0), items = vector<int>(), cells = vector<int>();
+
+    for (int pass = 0; pass < 2; pass++) {
+        vector<int> fill = vector<int>();
+        if (pass == 1) {
+            for (int c = 0; c < cellCount; c++)
+                start[c + 1] += start[c];
+            items.resize(start[cellCount]);
+            fill.assign(start.begin(), start.end() - 1);
+        }
+
+        for (int c = 0; c < cellCount; c++) {
+            for (int e = cellStart_[c]; e < cellStart_[c + 1]; e++) {
+                const int t = triangleRemap[cellItems_[e]];
+                if (t == -1)
+                    continue;
+
+                if (pass == 0)
+                    start[c + 1]++;
+                else
+                    items[fill[c]++] = t;
+            }
+        }
+
+        for (int t = firstNewTriangle; t < triangleCount; t++) {
+            OverlappedCells(mesh, t, cells);
+
+            for (const int cell: cells) {
+                if (pass == 0)
+                    start[cell + 1]++;
+                else
+                    items[fill[cell]++] = t;
+            }
+        }
+    }
+
+    cellStart_.swap(start);
+    cellItems_.swap(items);
+}
+
+void TriangleLocator::OverlappedCells(const NavMeshData &mesh, const int t, vector<int> &cells) const {
+    const vector<int> &indices = mesh.indices;
+    const int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+    Vector2Int from = CellOf(MathC::Min(MathC::Min(mesh.x[a], mesh.x[b]), mesh.x[c]),
+                             MathC::Min(MathC::Min(mesh.z[a], mesh.z[b]), mesh.z[c])),
+            to = CellOf(MathC::Max(MathC::Max(mesh.x[a], mesh.x[b]), mesh.x[c]),
+                        MathC::Max(MathC::Max(mesh.z[a], mesh.z[b]), mesh.z[c]));
+
+    cells.clear();
+    for (int z = from.y; z <= to.y; z++) {
+        for (int x = from.x; x <= to.x; x++) {
+            if (OverlapsCell(mesh, t, x, z))
+                cells.push_back(z * width_ + x);
+        }
+    }
+}
+
+/// <summary>
+///     Separating axis test between the triangle and the cell. The cell range already comes from the triangle
+///     bounds, so only the edge normals of the triangle are left to test.
+/// </summary>
+bool TriangleLocator::OverlapsCell(const NavMeshData &mesh, const int t, const int cellX, const int cellZ) const {
+    const vector<int> &indices = mesh.indices;
+    const float half = cellSize_ * 0.5f,
+            centerX = ((float) (cellX + originX_) + 0.5f) * cellSize_,
+            centerZ = ((float) (cellZ + originZ_) + 0.5f) * cellSize_;
+
+    float px[3], pz[3];
+    for (int k = 0; k < 3; k++) {
+        px[k] = mesh.x[indices[t * 3 + k]] - centerX;
+        pz[k] = mesh.z[indices[t * 3 + k]] - centerZ;
+    }
+
+    for (int k = 0; k < 3; k++) {
+        const float nx = pz[(k + 1) % 3] - pz[k], nz = px[k] - px[(k + 1) % 3];
+
+        float minP = nx * px[0] + nz * pz[0], maxP = minP;
+        for (int i = 1; i < 3; i++) {
+            const float p = nx * px[i] + nz * pz[i];
+            minP = MathC::Min(minP, p);
+            maxP = MathC::Max(maxP, p);
+        }
+
+        //A small margin keeps triangles touching the cell border listed, points on edges are accepted with a
+        //tolerance as well.
+        const float radius = half * (fabs(nx) + fabs(nz)) * 1.001f;
+        if (minP > radius || maxP < -radius)
+            return false;
+    }
+    return true;
+}
+
+Vector2Int TriangleLocator::CellOf(const float x, const float z) const {
+    float cx = MathC::Clamp(floor(x / cellSize_) - (float) originX_, 0.0f, (float) (width_ - 1)),
+            cz = MathC::Clamp(floor(z / cellSize_) - (float) originZ_, 0.0f, (float) (height_ - 1));
+
+    return {(int) cx, (int) cz};
+}
+
+template<class Policy>
+bool TriangleLocator::Contains(const NavMeshData &mesh, const int t, const float x, const float z,
+                               typename Policy::Scalar &u, typename Policy::Scalar &v) {
+    typedef typename Policy::Scalar Scalar;
+
+    const vector<int> &indices = mesh.indices;
+    const int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+
+    const Scalar ax = mesh.x[a], az = mesh.z[a],
+            v0x = mesh.x[b] - ax, v0z = mesh.z[b] - az,
+            v1x = mesh.x[c] - ax, v1z = mesh.z[c] - az,
+            v2x = x - ax, v2z = z - az;
+
+    const Scalar denominator = v0x * v1z - v1x * v0z;
+    if (fabs(denominator) < Scalar(1e-12))
+        return false;
+
+    constexpr Scalar tolerance = Policy::locateTolerance;
+    u = (v2x * v1z - v1x * v2z) / denominator;
+    v = (v0x * v2z - v2x * v0z) / denominator;
+    return u >= -tolerance && v >= -tolerance && u + v <= 1 + tolerance;
+}
+
+int TriangleLocator::FindTriangle(const NavMeshData &mesh, const float x, const float z) const {
+    if (width_ == 0)
+        return -1;
+
+    Vector2Int cell = CellOf(x, z);
+    const int c = cell.y * width_ + cell.x;
+
+    DefaultPolicy::Scalar u, v;
+    for (int e = cellStart_[c]; e < cellStart_[c + 1]; e++) {
+        if (Contains<DefaultPolicy>(mesh, cellItems_[e], x, z, u, v))
+            return cellItems_[e];
+    }
+    return -1;
+}
+
+void TriangleLocator::FindTriangles(const NavMeshData &mesh, const float minX, const float minZ, const float maxX,
+                                    const float maxZ, vector<int> &result) const {
+    result.clear();
+    if (width_ == 0)
+        return;
+
+    const vector<int> &indices = mesh.indices;
+    const Vector2Int from = CellOf(minX, minZ), to = CellOf(maxX, maxZ);
+
+    for (int z = from.y; z <= to.y; z++) {
+        for (int x = from.x; x <= to.x; x++) {
+            const int c = z * width_ + x;
+            for (int e = cellStart_[c]; e < cellStart_[c + 1]; e++) {
+                const int t = cellItems_[e], a = indices[t * 3], b = indices[t * 3 + 1], d = indices[t * 3 + 2];
+
+                if (maxX < MathC::Min(MathC::Min(mesh.x[a], mesh.x[b]), mesh.x[d]) ||
+                    minX > MathC::Max(MathC::Max(mesh.x[a], mesh.x[b]), mesh.x[d]) ||
+                    maxZ < MathC::Min(MathC::Min(mesh.z[a], mesh.z[b]), mesh.z[d]) ||
+                    minZ > MathC::Max(MathC::Max(mesh.z[a], mesh.z[b]), mesh.z[d]))
+                    continue;
+
+                result.push_back(t);
+            }
+        }
+    }
+
+    //A triangle spanning several cells is listed once per cell.
+    sort(result.begin(), result.end());
+    result.erase(unique(result.begin(), result.end()), result.end());
+}
+
+int TriangleLocator::FindTriangle(const NavMeshData &mesh, const Vector3 &point) const {
+    if (width_ == 0)
+        return -1;
+
+    const vector<int> &indices = mesh.indices;
+    Vector2Int cell = CellOf(point.x, point.z);
+    const int c = cell.y * width_ + cell.x;
+
+    int best = -1;
+    float bestHeight = 0;
+    DefaultPolicy::Scalar u, v;
+    for (int e = cellStart_[c]; e < cellStart_[c + 1]; e++) {
+        const int t = cellItems_[e];
+        if (!Contains<DefaultPolicy>(mesh, t, point.x, point.z, u, v))
+            continue;
+
+        const int a = indices[t * 3], b = indices[t * 3 + 1], cc = indices[t * 3 + 2];
+        const float height = (float) fabs(mesh.y[a] + u * (mesh.y[b] - mesh.y[a]) +
+                                          v * (mesh.y[cc] - mesh.y[a]) - point.y);
+        if (best == -1 || height < bestHeight) {
+            best = t;
+            bestHeight = height;
+        }
+    }
+    return best;
+}
+
+/// <summary>
+///     Closest point on a triangle in 3D, by the Voronoi region of the point (Ericson, Real-Time Collision
+///     Detection 5.1.5).
+/// </summary>
+template<class Policy>
+Vector3 TriangleLocator::ClosestPointOnTriangle(const NavMeshData &mesh, const int t, const Vector3 &p) {
+    typedef typename Policy::Scalar Scalar;
+
+    const vector<int> &indices = mesh.indices;
+    const int ia = indices[t * 3], ib = indices[t * 3 + 1], ic = indices[t * 3 + 2];
+    const Scalar a[3] = {mesh.x[ia], mesh.y[ia], mesh.z[ia]},
+            b[3] = {mesh.x[ib], mesh.y[ib], mesh.z[ib]},
+            c[3] = {mesh.x[ic], mesh.y[ic], mesh.z[ic]},
+            q[3] = {p.x, p.y, p.z};
+
+    Scalar ab[3], ac[3], ap[3], bp[3], cp[3];
+    for (int i = 0; i < 3; i++) {
+        ab[i] = b[i] - a[i];
+        ac[i] = c[i] - a[i];
+        ap[i] = q[i] - a[i];
+        bp[i] = q[i] - b[i];
+        cp[i] = q[i] - c[i];
+    }
+
+    auto dot = [](const Scalar *l, const Scalar *r) { return l[0] * r[0] + l[1] * r[1] + l[2] * r[2]; };
+    auto at = [&](const Scalar s, const Scalar w) {
+        return Vector3((float) (a[0] + s * ab[0] + w * ac[0]), (float) (a[1] + s * ab[1] + w * ac[1]),
+                       (float) (a[2] + s * ab[2] + w * ac[2]));
+    };
+
+    const Scalar d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if (d1 <= 0 && d2 <= 0)
+        return at(0, 0);
+
+    const Scalar d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if (d3 >= 0 && d4 <= d3)
+        return at(1, 0);
+
+    const Scalar vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0)
+        return at(d1 / (d1 - d3), 0);
+
+    const Scalar d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if (d6 >= 0 && d5 <= d6)
+        return at(0, 1);
+
+    const Scalar vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0)
+        return at(0, d2 / (d2 - d6));
+
+    const Scalar va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        const Scalar w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return at(1 - w, w);
+    }
+
+    const Scalar denominator = va + vb + vc;
+    if (denominator == 0)
+        return at(0, 0);
+    return at(vb / denominator, vc / denominator);
+}
+
+bool TriangleLocator::ClosestPointOnMesh(const NavMeshData &mesh, const Vector3 &point, Vector3 &closest,
+                                         int &triangle) const {
+    triangle = -1;
+    if (width_ == 0)
+        return false;
+
+    Vector2Int cell = CellOf(point.x, point.z);
+    float bestDistance = 0;
+
+    //A cell in ring r is at least (r - 1) cells away from the point in the XZ plane, which bounds the 3D
+    //distance as well. Points outside the grid are projected onto it, which only brings cells closer.
+    const int maxRing = max(width_, height_);
+    for (int ring = 0; ring <= maxRing; ring++) {
+        if (triangle != -1 && bestDistance <= (float) (ring - 1) * cellSize_)
+            break;
+
+        for (int z = cell.y - ring; z <= cell.y + ring; z++) {
+            if (z < 0 || z >= height_)
+                continue;
+
+            //Only the border of the ring, the inside was searched before.
+            const int step = (z == cell.y - ring || z == cell.y + ring) ? 1 : 2 * ring;
+            for (int x = cell.x - ring; x <= cell.x + ring; x += step) {
+                if (x < 0 || x >= width_)
+                    continue;
+
+                const int c = z * width_ + x;
+                for (int e = cellStart_[c]; e < cellStart_[c + 1]; e++) {
+                    const int t = cellItems_[e];
+                    const Vector3 candidate = ClosestPointOnTriangle<DefaultPolicy>(mesh, t, point);
+                    const float distance = Vector3::Distance(candidate, point);
+
+                    if (triangle == -1 || distance < bestDistance) {
+                        triangle = t;
+                        bestDistance = distance;
+                        closest = candidate;
+                    }
+                }
+            }
+        }
+    }
+
+    return triangle != -1;
+}
+
+float TriangleLocator::CellSize() const {
+    return cellSize_;
+}
+
+int TriangleLocator::OriginX() const {
+    return originX_;
+}
+
+int TriangleLocator::OriginZ() const {
+    return originZ_;
+}
+
+int TriangleLocator::Width() const {
+    return width_;
+}
+
+int TriangleLocator::Height() const {
+    return height_;
+}
+
+const vector<int> &TriangleLocator::CellStart() const {
+    return cellStart_;
+}
+
+const vector<int> &TriangleLocator::CellItems() const {
+    return cellItems_;
+}
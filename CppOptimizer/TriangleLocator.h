@@ -0,0 +1,106 @@
+#ifndef CPPOPTIMIZER_TRIANGLELOCATOR_H
+#define CPPOPTIMIZER_TRIANGLELOCATOR_H
+
+#include <vector>
+#include "NavMeshData.h"
+#include "Vector2Int.h"
+#include "Vector3.h"
+
+using namespace std;
+
+class NavMeshBinaryView;
+
+/// <summary>
+///     Point location over the XZ plane.
+///     Every triangle is rasterized into each grid cell its area overlaps, not only the cells of its vertices, and
+///     the cells are stored as a flat CSR table: the triangles of cell c are cellItems[cellStart[c]] up to
+///     cellItems[cellStart[c + 1]]. A lookup only tests the triangles of one cell, so it runs in constant expected
+///     time. The locator holds no reference to the mesh, queries take the mesh it was built for.
+/// </summary>
+class TriangleLocator {
+private:
+    float cellSize_;
+    int originX_, originZ_, width_, height_;
+    vector<int> cellStart_, cellItems_;
+
+    bool OverlapsCell(const NavMeshData &mesh, int t, int cellX, int cellZ) const;
+
+    void OverlappedCells(const NavMeshData &mesh, int t, vector<int> &cells) const;
+
+    /// <summary>
+    ///     Barycentric weights of b and c for the point, false when it is outside the triangle. Computes in the
+    ///     Scalar of the policy, within its locate tolerance.
+    /// </summary>
+    template<class Policy>
+    static bool Contains(const NavMeshData &mesh, int t, float x, float z, typename Policy::Scalar &u,
+                         typename Policy::Scalar &v);
+
+    template<class Policy>
+    static Vector3 ClosestPointOnTriangle(const NavMeshData &mesh, int t, const Vector3 &p);
+
+public:
+    TriangleLocator();
+
+    /// <summary>
+    ///     Indexes the triangles of the mesh. The cell size is doubled until the cell count stays within a small
+    ///     multiple of the triangle count.
+    /// </summary>
+    void Build(const NavMeshData &mesh, float cellSize);
+
+    /// <summary>
+    ///     Updates the index after triangles were removed and added. The triangles kept their relative order,
+    ///     triangleRemap maps every old id to the new one or -1 when it was removed, and the triangles from
+    ///     firstNewTriangle on are new. Only the new triangles are rasterized, unless one of them lies outside the
+    ///     grid, in which case the index is built again.
+    /// </summary>
+    void Update(const NavMeshData &mesh, float cellSize, const vector<int> &triangleRemap, int firstNewTriangle);
+
+    /// <summary>
+    ///     Takes the index from the spatial buckets of a binary file, which must have them, without rasterizing.
+    /// </summary>
+    void Load(const NavMeshBinaryView &view);
+
+    /// <summary>
+    ///     Cell coordinate of the position relative to the grid origin, clamped to the grid.
+    /// </summary>
+    Vector2Int CellOf(float x, float z) const;
+
+    /// <returns>The lowest id of the triangles containing the point in the XZ plane, or -1.</returns>
+    int FindTriangle(const NavMeshData &mesh, float x, float z) const;
+
+    /// <returns>
+    ///     The triangle containing the point in the XZ plane and closest to it in height, so the right floor is
+    ///     picked where floors are stacked, or -1.
+    /// </returns>
+    int FindTriangle(const NavMeshData &mesh, const Vector3 &point) const;
+
+    /// <summary>
+    ///     Ids of the triangles whose XZ bounds overlap the box, in ascending order.
+    /// </summary>
+    void FindTriangles(const NavMeshData &mesh, float minX, float minZ, float maxX, float maxZ,
+                       vector<int> &result) const;
+
+    /// <summary>
+    ///     Closest point on the surface of the mesh, searched in rings of cells around the point until no nearer
+    ///     cell can remain.
+    /// </summary>
+    /// <returns>False when the mesh is empty.</returns>
+    bool ClosestPointOnMesh(const NavMeshData &mesh, const Vector3 &point, Vector3 &closest, int &triangle) const;
+
+    float CellSize() const;
+
+    int OriginX() const;
+
+    int OriginZ() const;
+
+    int Width() const;
+
+    int Height() const;
+
+    const vector<int> &CellStart() const;
+
+    const vector<int> &CellItems() const;
+};
+
+
+#endif //CPPOPTIMIZER_TRIANGLELOCATOR_H
@@ -0,0 +1,152 @@
+#include <cmath>
+#include "UniformGrid.h"
+#include "MathC.h"
+
+using namespace std;
+
+UniformGrid::UniformGrid() {
+    cellSize_ = 1.0f;
+    originX_ = 0;
+    originZ_ = 0;
+    width_ = 0;
+    height_ = 0;
+}
+
+void UniformGrid::Reset(float minX, float minZ, float maxX, float maxZ, float cellSize, int expectedItems) {
+    const long long maxCells = 4LL * expectedItems + 1024;
+
+    cellSize_ = cellSize;
+    while (true) {
+        originX_ = (int) floor(minX / cellSize_);
+        originZ_ = (int) floor(minZ / cellSize_);
+        width_ = (int) floor(maxX / cellSize_) - originX_ + 1;
+        height_ = (int) floor(maxZ / cellSize_) - originZ_ + 1;
+
+        if ((long long) width_ * height_ <= maxCells)
+            break;
+
+        cellSize_ *= 2.0f;
+    }
+
+    head_.assign(width_ * height_, -1);
+    tail_.assign(width_ * height_, -1);
+    next_.clear();
+    items_.clear();
+    next_.reserve(expectedItems);
+    items_.reserve(expectedItems);
+}
+
+void UniformGrid::Insert(int item, float x, float z) {
+    Vector2Int cell = CellOf(x, z);
+    Append(cell.y * width_ + cell.x, item);
+}
+
+void UniformGrid::Append(int cell, int item) {
+    int entry = (int) items_.size();
+    items_.push_back(item);
+    next_.push_back(-1);
+
+    if (tail_[cell] == -1)
+        head_[cell] = entry;
+    else
+        next_[tail_[cell]] = entry;
+    tail_[cell] = entry;
+}
+
+void UniformGrid::Insert(int item, float minX, float minZ, float maxX, float maxZ) {
+    Vector2Int from = CellOf(minX, minZ), to = CellOf(maxX, maxZ);
+
+    for (int z = from.y; z <= to.y; z++) {
+        for (int x = from.x; x <= to.x; x++) {
+            Append(z * width_ + x, item);
+        }
+    }
+}
+
+void UniformGrid::InsertOrdered(int item, float minX, float minZ, float maxX, float maxZ) {
+    Vector2Int from = CellOf(minX, minZ), to = CellOf(maxX, maxZ);
+
+    for (int z = from.y; z <= to.y; z++) {
+        for (int x = from.x; x <= to.x; x++) {
+            int cell = z * width_ + x, previous = -1, e = head_[cell];
+            while (e != -1 && items_[e] < item) {
+                previous = e;
+                e = next_[e];
+            }
+
+            int entry = (int) items_.size();
+            items_.push_back(item);
+            next_.push_back(e);
+
+            if (previous == -1)
+                head_[cell] = entry;
+            else
+                next_[previous] = entry;
+            if (e == -1)
+                tail_[cell] = entry;
+        }
+    }
+}
+
+void UniformGrid::Remove(int item, float minX, float minZ, float maxX, float maxZ) {
+    Vector2Int from = CellOf(minX, minZ), to = CellOf(maxX, maxZ);
+
+    for (int z = from.y; z <= to.y; z++) {
+        for (int x = from.x; x <= to.x; x++) {
+            int cell = z * width_ + x, previous = -1, e = head_[cell];
+            while (e != -1 && items_[e] != item) {
+                previous = e;
+                e = next_[e];
+            }
+
+            if (e == -1)
+                continue;
+
+            if (previous == -1)
+                head_[cell] = next_[e];
+            else
+                next_[previous] = next_[e];
+            if (tail_[cell] == e)
+                tail_[cell] = previous;
+        }
+    }
+}
+
+Vector2Int UniformGrid::CellOf(float x, float z) const {
+    float cx = MathC::Clamp(floor(x / cellSize_) - (float) originX_, 0.0f, (float) (width_ - 1)),
+            cz = MathC::Clamp(floor(z / cellSize_) - (float) originZ_, 0.0f, (float) (height_ - 1));
+
+    return {(int) cx, (int) cz};
+}
+
+int UniformGrid::Head(int cellX, int cellZ) const {
+    return head_[cellZ * width_ + cellX];
+}
+
+int UniformGrid::Next(int entry) const {
+    return next_[entry];
+}
+
+int UniformGrid::Item(int entry) const {
+    return items_[entry];
+}
+
+float UniformGrid::CellSize() const {
+    return cellSize_;
+}
+
+int UniformGrid::OriginX() const {
+    return originX_;
+}
+
+int UniformGrid::OriginZ() const {
+    return originZ_;
+}
+
+int UniformGrid::Width() const {
+    return width_;
+}
+
+int UniformGrid::Height() const {
+    return height_;
+}
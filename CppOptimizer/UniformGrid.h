@@ -0,0 +1,81 @@
+#ifndef CPPOPTIMIZER_UNIFORMGRID_H
+#define CPPOPTIMIZER_UNIFORMGRID_H
+
+#include <vector>
+#include "Vector2Int.h"
+
+using namespace std;
+
+/// <summary>
+///     Dense bucket grid over the XZ plane stored in flat arrays.
+///     Every cell keeps a singly linked list of entries so items can be appended after the grid has been
+///     filled without any per cell allocations. Items are visited in the order they were inserted.
+/// </summary>
+class UniformGrid {
+private:
+    float cellSize_;
+    int originX_, originZ_, width_, height_;
+
+    vector<int> head_, tail_;
+    vector<int> next_, items_;
+
+    void Append(int cell, int item);
+
+public:
+    UniformGrid();
+
+    /// <summary>
+    ///     Clears the grid and sizes it to cover the given bounds. The cell size is doubled until the cell count
+    ///     stays within a small multiple of the expected item count, so sparse worlds do not blow up the grid.
+    /// </summary>
+    void Reset(float minX, float minZ, float maxX, float maxZ, float cellSize, int expectedItems);
+
+    void Insert(int item, float x, float z);
+
+    /// <summary>
+    ///     Inserts the item into every cell overlapped by the bounding box.
+    /// </summary>
+    void Insert(int item, float minX, float minZ, float maxX, float maxZ);
+
+    /// <summary>
+    ///     Inserts the item into every cell overlapped by the bounding box, ahead of the first entry with a larger
+    ///     item, so a grid filled in item order stays in that order when an item is removed and inserted again.
+    /// </summary>
+    void InsertOrdered(int item, float minX, float minZ, float maxX, float maxZ);
+
+    /// <summary>
+    ///     Unlinks the item from every cell overlapped by the bounding box it was inserted with. The entries are not
+    ///     reused until the next Reset.
+    /// </summary>
+    void Remove(int item, float minX, float minZ, float maxX, float maxZ);
+
+    /// <summary>
+    ///     Cell coordinate of the position relative to the grid origin, clamped to the grid.
+    /// </summary>
+    Vector2Int CellOf(float x, float z) const;
+
+    /// <summary>
+    ///     First entry of the cell or -1 when empty. Walk the cell with Next and read the item with Item.
+    /// </summary>
+    int Head(int cellX, int cellZ) const;
+
+    int Next(int entry) const;
+
+    int Item(int entry) const;
+
+    float CellSize() const;
+
+    /// <summary>
+    ///     Cell coordinate of the first column and row, in whole cells from the world origin.
+    /// </summary>
+    int OriginX() const;
+
+    int OriginZ() const;
+
+    int Width() const;
+
+    int Height() const;
+};
+
+
+#endif //CPPOPTIMIZER_UNIFORMGRID_H
@@ -0,0 +1,123 @@
+#include <cmath>
+#include "VertexWeld.h"
+#include "UniformGrid.h"
+#include "MathC.h"
+#include "Profiler.h"
+
+using namespace std;
+
+int VertexWeld::Find(vector<int> &parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+
+    return i;
+}
+
+int VertexWeld::Weld(NavMeshData &mesh, const float weldDistance, const int firstFreeVertex) {
+    PROFILE_SCOPE("CheckOverlap");
+
+    const int vertexCount = mesh.VertexCount();
+    if (vertexCount == 0)
+        return 0;
+
+    vector<float> &xs = mesh.x, &ys = mesh.y, &zs = mesh.z;
+    vector<int> &indices = mesh.indices;
+
+    float minX = xs[0], minZ = zs[0], maxX = xs[0], maxZ = zs[0];
+    for (int i = 1; i < vertexCount; i++) {
+        minX = MathC::Min(minX, xs[i]);
+        minZ = MathC::Min(minZ, zs[i]);
+        maxX = MathC::Max(maxX, xs[i]);
+        maxZ = MathC::Max(maxZ, zs[i]);
+    }
+
+    //Cells twice the weld distance wide with a padded search radius keep every query within 3x3 cells while
+    //staying safe from rounding in the distance check.
+    UniformGrid grid = UniformGrid();
+    grid.Reset(minX, minZ, maxX, maxZ, weldDistance * 2.0f, vertexCount);
+    for (int i = 0; i < vertexCount; i++)
+        grid.Insert(i, xs[i], zs[i]);
+
+    const float searchRadius = weldDistance * 1.5f;
+
+    vector<int> parent = vector<int>(vertexCount);
+    for (int i = 0; i < vertexCount; i++)
+        parent[i] = i;
+
+    int welded = 0;
+    for (int current = 0; current < vertexCount; current++) {
+        if (parent[current] != current)
+            continue;
+
+        const float cx = xs[current], cy = ys[current], cz = zs[current];
+        Vector2Int from = grid.CellOf(cx - searchRadius, cz - searchRadius),
+                to = grid.CellOf(cx + searchRadius, cz + searchRadius);
+
+        for (int z = from.y; z <= to.y; z++) {
+            for (int x = from.x; x <= to.x; x++) {
+                for (int e = grid.Head(x, z); e != -1; e = grid.Next(e)) {
+                    int other = grid.Item(e);
+
+                    if (other == current || other < firstFreeVertex || parent[other] != other)
+                        continue;
+
+                    float dx = cx - xs[other], dy = cy - ys[other], dz = cz - zs[other];
+                    if (sqrt(dx * dx + dy * dy + dz * dz) > weldDistance)
+                        continue;
+
+                    parent[other] = current;
+                    welded++;
+                }
+            }
+        }
+    }
+
+    //Compaction pass, surviving vertices keep their relative order.
+    vector<int> remap = vector<int>(vertexCount);
+    int kept = 0;
+    for (int i = 0; i < vertexCount; i++) {
+        if (parent[i] != i)
+            continue;
+
+        remap[i] = kept;
+        xs[kept] = xs[i];
+        ys[kept] = ys[i];
+        zs[kept] = zs[i];
+        kept++;
+    }
+    xs.resize(kept);
+    ys.resize(kept);
+    zs.resize(kept);
+
+    //Remap pass, collapsed and invalid triangles are dropped while the rest keep their order.
+    int write = 0;
+    for (int i = 0; i + 2 < (int) indices.size(); i += 3) {
+        int t[3];
+        bool valid = true;
+        for (int k = 0; k < 3; k++) {
+            int index = indices[i + k];
+            if (index < 0 || index >= vertexCount) {
+                valid = false;
+                break;
+            }
+
+            t[k] = remap[Find(parent, index)];
+        }
+
+        if (!valid || t[0] == t[1] || t[0] == t[2] || t[1] == t[2])
+            continue;
+
+        indices[write] = t[0];
+        indices[write + 1] = t[1];
+        indices[write + 2] = t[2];
+        write += 3;
+    }
+    PROFILE_COUNT("Vertices welded", welded);
+    PROFILE_COUNT("Triangles dropped by weld", (int) indices.size() / 3 - write / 3);
+
+    indices.resize(write);
+
+    return welded;
+}
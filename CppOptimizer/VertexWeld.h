@@ -0,0 +1,29 @@
+#ifndef CPPOPTIMIZER_VERTEXWELD_H
+#define CPPOPTIMIZER_VERTEXWELD_H
+
+#include <vector>
+#include "NavMeshData.h"
+
+using namespace std;
+
+/// <summary>
+///     Merges vertices that lie within the weld distance of each other.
+///     Vertices are visited in index order and every vertex still alive absorbs all other live vertices within
+///     the weld distance. Absorbed vertices are recorded in a union-find remap table, the vertex array is compacted
+///     in a single pass and the index array is rewritten in a single pass. Triangles that collapse are dropped.
+/// </summary>
+class VertexWeld {
+private:
+    static int Find(vector<int> &parent, int i);
+
+public:
+    /// <param name="firstFreeVertex">
+    ///     Vertices below this id are fixed: they absorb other vertices but are never absorbed themselves, so they
+    ///     keep their position and id.
+    /// </param>
+    /// <returns>Number of vertices that were merged into another vertex.</returns>
+    static int Weld(NavMeshData &mesh, float weldDistance, int firstFreeVertex = 0);
+};
+
+
+#endif //CPPOPTIMIZER_VERTEXWELD_H
@@ -6,6 +6,11 @@
 #include <nlohmann/json.hpp>
 #include <map>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
 
 using json = nlohmann::json;
 
@@ -15,618 +20,373 @@ using namespace chrono;
 namespace fs = filesystem;
 
 #include "NavMeshImport.h"
+#include "NavMeshJsonReader.h"
+#include "NavMeshBinary.h"
 #include "NavMeshOptimized.h"
 #include "MathC.h"
 #include "Vector2Int.h"
 #include "Vector3.h"
 #include "OptimizedResult.h"
-
-void CheckOverlap(vector<Vector3> &verts, vector<int> &indices,
-                  map<Vector2Int, vector<int>> &vertsByPosition, float size);
-
-void
-SetupNavTriangles(const vector<int> &indices, vector<NavMeshTriangle> &triangles,
-                  map<int, vector<int>> &trianglesByVertexId);
-
-void SetupNeighbors(vector<NavMeshTriangle> &triangles, map<int, vector<int>> &trianglesByVertexId);
-
-void FillHoles(vector<Vector3> &verts, vector<int> &indices);
-
-vector<int> SharedBetween(const vector<int> &v1, const vector<int> &v2);
+#include "NavMeshData.h"
+#include "ThreadPool.h"
+#include "GeometryPolicy.h"
+#include "NavMeshOptimizer.h"
+#include "Profiler.h"
 
 void writeCsv(fs::path &fileName, OptimizedResult &r);
 
-NavMeshImport loadJsonToNavMeshImport(fs::path &file) {
-    cout << "   Importing navigation mesh from file:" << "\n";
-    cout << "   " << file << "\n";
-
-    ifstream str(file);
-    json js = json::parse(str);
+void writeOptimizedJson(const fs::path &fileName, const vector<float> &cleanPoint, NavMeshOptimized &optimized);
 
-    vector<float> cleanPoint = vector<float>{(float) js["cleanPoint"]["x"],
-                                             (float) js["cleanPoint"]["y"],
-                                             (float) js["cleanPoint"]["z"]};
-    cout << "   Clean Point {" << (float) cleanPoint[0] << " , " << (float) cleanPoint[1] << " , "
-         << (float) cleanPoint[2] << "}" << "\n";
+int RunBatch(const vector<fs::path> &inputs, ThreadPool &pool, bool binary, int minIslandTriangles,
+             HoleFillMode holeFillMode, bool decimate);
 
-    vector<Vector3> vertexPoints = vector<Vector3>();
-
-    for (int i = 0; i < (int) js["x"].size(); ++i) {
-        vertexPoints.emplace_back((float) js["x"][i], (float) js["y"][i], (float) js["z"][i]);
+NavMeshImport loadNavMeshImport(const fs::path &file, const bool log = true) {
+    if (log) {
+        cout << "   Importing navigation mesh from file:" << "\n";
+        cout << "   " << file << "\n";
     }
 
-    cout << "   Vertex count: " << vertexPoints.size() << "\n";
-
-    vector<int> indices = vector<int>();
-
-    for (const auto &item: js["indices"])
-        indices.push_back((int) item);
+    NavMeshImport navMeshImport = file.extension() == ".navbin"
+                                  ? NavMeshBinaryView(file).ToImport()
+                                  : NavMeshJsonReader::Load(file);
 
-    cout << "   Indices count: " << indices.size() << "\n\n";
+    if (log) {
+        vector<float> &cleanPoint = navMeshImport.getCleanPoint();
+        cout << "   Clean Point {" << cleanPoint[0] << " , " << cleanPoint[1] << " , " << cleanPoint[2] << "}" << "\n";
+        cout << "   Vertex count: " << navMeshImport.getVertices().size() << "\n";
+        cout << "   Indices count: " << navMeshImport.getIndices().size() << "\n\n";
+    }
 
-    return {cleanPoint, vertexPoints, indices,
-            (int) js["finalVertexCount"],
-            (int) js["finalIndicesCount"],
-            (int) js["finalTriangleCount"]};
+    return navMeshImport;
 }
 
-NavMeshOptimized OptimizeNavMesh(const Vector3 cleanPoint, vector<Vector3> &verts, vector<int> &indices) {
-#pragma region Check Vertices and Indices for overlap
-
-    map<Vector2Int, vector<int>> vertsByPosition = map<Vector2Int, vector<int>>();
-
-    const float groupSize = 5.0f;
+static const char *usage =
+        "Usage: CppOptimizer [--threads N] [--min-island N] [--arena] [--boundary-loops] [--decimate]\n"
+        "       CppOptimizer --batch [--threads N] [--binary] [--min-island N] [--boundary-loops] [--decimate] "
+        "<directory or file>...\n";
+
+/// <summary>
+///     Parses a count option value, which must be a whole non negative number that fits an int.
+/// </summary>
+/// <returns>False when the text is not such a number, in which case the value is left unchanged.</returns>
+static bool ParseCount(const char *text, int &value) {
+    const char *end = text + strlen(text);
+    int parsed = 0;
+    const from_chars_result result = from_chars(text, end, parsed);
+    if (result.ec != errc() || result.ptr != end || parsed < 0)
+        return false;
+
+    value = parsed;
+    return true;
+}
 
-    for (int i = 0; i < (int) verts.size(); i++) {
-        Vector3 &v = verts[i];
-        Vector2Int id = Vector2Int((int) floor(v.x / groupSize),
-                                   (int) floor(v.z / groupSize));
+int main(int argc, char *argv[]) {
+    cout << setprecision(8);
+    const int averageCount = 1000;
 
-        if (vertsByPosition.find(id) == vertsByPosition.end()) {
-            vertsByPosition.insert({id, vector<int>()});
+    //--threads N sets the total thread count including the main thread, 0 uses every hardware thread.
+    //--batch followed by directories or mesh files optimizes every mesh once, in parallel, instead of benchmarking.
+    //--binary writes the batch results as navbin files instead of json.
+    //--min-island N also keeps islands away from the clean point holding at least N triangles.
+    //--arena reuses one buffer for the temporaries of every benchmark repeat, released after each repeat.
+    //--boundary-loops closes holes by triangulating the boundary loops instead of testing candidate triangles.
+    //--decimate collapses vertices on flat parts of the mesh after the holes are filled.
+    int threadCount = -1, minIslandTriangles = 0;
+    bool batch = false, binary = false, useArena = false, decimate = false;
+    HoleFillMode holeFillMode = HoleFillMode::Candidates;
+    vector<fs::path> batchInputs = vector<fs::path>();
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if ((arg == "--threads" || arg == "--min-island") && i + 1 < argc) {
+            if (!ParseCount(argv[++i], arg == "--threads" ? threadCount : minIslandTriangles)) {
+                cout << "Invalid value " << argv[i] << " for " << arg << ", expected a non negative number\n"
+                     << usage;
+                return 1;
+            }
         }
-
-        vertsByPosition[id].push_back(i);
-    }
-
-    CheckOverlap(verts, indices, vertsByPosition, groupSize);
-
-#pragma endregion
-
-#pragma region Create first iteration of NavTriangles
-
-    vector<NavMeshTriangle> triangles = vector<NavMeshTriangle>();
-    map<int, vector<int>> trianglesByVertexId = map<int, vector<int>>();
-    for (int i = 0; i < (int) verts.size(); i++)
-        trianglesByVertexId.insert({i, vector<int>()});
-
-    SetupNavTriangles(indices, triangles, trianglesByVertexId);
-
-    SetupNeighbors(triangles, trianglesByVertexId);
-
-#pragma endregion
-
-#pragma region Check neighbor connections
-
-    int closestVert = 0;
-    float closestDistance = Vector3::Distance(cleanPoint, verts[closestVert]);
-
-    for (int i = 1; i < (int) verts.size(); i++) {
-        const float d = Vector3::Distance(cleanPoint, verts[i]);
-
-        if (d >= closestDistance)
-            continue;
-
-        if (trianglesByVertexId.find(i) != trianglesByVertexId.end()) {
-            bool found = false;
-            for (const int &t: trianglesByVertexId[i])
-                if (!triangles[t].neighbors().empty()) {
-                    found = true;
-                    break;
-                }
-
-            if (!found)
-                continue;
+        else if (arg == "--batch")
+            batch = true;
+        else if (arg == "--binary")
+            binary = true;
+        else if (arg == "--arena")
+            useArena = true;
+        else if (arg == "--boundary-loops")
+            holeFillMode = HoleFillMode::BoundaryLoops;
+        else if (arg == "--decimate")
+            decimate = true;
+        else if (arg.rfind("--", 0) == 0) {
+            cout << "Unknown or incomplete option " << arg << "\n" << usage;
+            return 1;
         }
-
-        closestDistance = d;
-        closestVert = i;
+        else
+            batchInputs.emplace_back(arg);
     }
 
-    vector<int> connected = vector<int>(), toCheck = vector<int>();
-    toCheck.insert(toCheck.end(), trianglesByVertexId[closestVert].begin(), trianglesByVertexId[closestVert].end());
-
-    while (!toCheck.empty()) {
-        int index = toCheck[0];
-        NavMeshTriangle navTriangle = triangles[index];
-        toCheck.erase(toCheck.begin());
-        connected.push_back(index);
-
-        for (int &n: navTriangle.neighbors()) {
-            if (find(toCheck.begin(), toCheck.end(), n) == toCheck.end() &&
-                find(connected.begin(), connected.end(), n) == connected.end())
-                toCheck.push_back(n);
-        }
+    if (!batch && !batchInputs.empty()) {
+        cout << "Mesh files are only taken with --batch\n" << usage;
+        return 1;
     }
 
-#pragma endregion
-
-#pragma region Fill holes and final iteration of NavTriangles
+    if (threadCount == -1)
+        threadCount = batch ? 0 : 1;
 
-    vector<Vector3> fixedVertices = vector<Vector3>();
-    vector<int> fixedIndices = vector<int>();
+    ThreadPool pool = ThreadPool(threadCount);
+    cout << "Threads: " << pool.ThreadCount() << "\n";
 
-    for (const int &i: connected) {
-        for (const int tVertex: triangles[i].vertices()) {
-            if (find(fixedVertices.begin(), fixedVertices.end(), verts[tVertex]) == fixedVertices.end())
-                fixedVertices.push_back(verts[tVertex]);
+    if (batch)
+        return RunBatch(batchInputs, pool, binary, minIslandTriangles, holeFillMode, decimate);
 
-            int elementIndex = (int) distance(fixedVertices.begin(),
-                                              std::find(fixedVertices.begin(), fixedVertices.end(), verts[tVertex]));
-            fixedIndices.push_back(elementIndex);
+    const vector<string> file_letter = {"S", "M", "L"};
 
-            Vector2Int id = Vector2Int((int) floor(verts[tVertex].x / groupSize),
-                                       (int) floor(verts[tVertex].z / groupSize));
+    //Runs that outgrow the buffer continue on the heap.
+    const size_t arenaBytes = 32 << 20;
+    vector<char> arenaBuffer = vector<char>(useArena ? arenaBytes : 0);
+    pmr::monotonic_buffer_resource arena = pmr::monotonic_buffer_resource(arenaBuffer.data(), arenaBuffer.size());
 
-            if (vertsByPosition.find(id) == vertsByPosition.end())
-                vertsByPosition.insert({id, vector<int>()});
+    const fs::path root_path = fs::current_path().parent_path().parent_path();
+    const fs::path folder_path = root_path / "JsonFiles";
+    cout << "Using json text files from folder:\n" << folder_path << "\n";
 
-            vertsByPosition[id].push_back(elementIndex);
-        }
-    }
+    for (int letter_index = 0; letter_index < 3; ++letter_index) {
+        for (int number_index = 1; number_index <= 5; ++number_index) {
+            const string name = file_letter[letter_index] + " " + to_string(number_index);
 
-    FillHoles(fixedVertices, fixedIndices);
+            cout << "Optimization for: " << name << '\n';
 
-    vector<NavMeshTriangle> fixedTriangles = vector<NavMeshTriangle>();
-    map<int, vector<int>> fixedTrianglesByVertexId = map<int, vector<int>>();
-    for (int i = 0; i < (int) fixedVertices.size(); i++)
-        fixedTrianglesByVertexId.insert({i, vector<int>()});
+            Profiler::Reset();
 
-    SetupNavTriangles(fixedIndices, fixedTriangles, fixedTrianglesByVertexId);
+            NavMeshImport navMeshImport = loadNavMeshImport(folder_path / (name + ".json"));
 
-    SetupNeighbors(fixedTriangles, fixedTrianglesByVertexId);
+            const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0],
+                                               navMeshImport.getCleanPoint()[1],
+                                               navMeshImport.getCleanPoint()[2]);
 
-    for (int i = 0; i < (int) fixedTriangles.size(); i++)
-        fixedTriangles[i].SetBorderWidth(fixedVertices, fixedTriangles);
+            double total_time = 0;
+            OptimizedResult allOptimized = OptimizedResult(averageCount);
+            NavMeshOptimized navMeshOptimized = NavMeshOptimized();
 
-#pragma endregion
+            //Nothing is written to the console inside the loop, the last result is reported once it is done.
+            for (int i = 0; i < averageCount; ++i) {
+                NavMeshData mesh = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
 
-    NavMeshOptimized result = NavMeshOptimized();
-    result.SetValues(fixedVertices, fixedIndices, fixedTriangles, groupSize);
-    return result;
-}
+                auto timerStart = high_resolution_clock::now();
 
-void CheckOverlap(vector<Vector3> &verts, vector<int> &indices,
-                  map<Vector2Int, vector<int>> &vertsByPos,
-                  const float groupSize) {
-    const float overlapCheckDistance = 0.3f;
-    map<int, vector<int>> removed = map<int, vector<int>>();
+                navMeshOptimized = OptimizeNavMesh(cleanPoint, mesh, &pool, minIslandTriangles,
+                                                   useArena ? &arena : nullptr, holeFillMode, decimate);
 
-    for (int currentVertIndex = 0; currentVertIndex < (int) verts.size(); currentVertIndex++) {
+                const double time = duration<double, milli>(high_resolution_clock::now() - timerStart).count();
 
-        int iFloor = (int) floor((float) currentVertIndex / groupSize);
-        if (removed.find(iFloor) != removed.end()) {
-            if (find(removed[iFloor].begin(), removed[iFloor].end(), currentVertIndex) != removed[iFloor].end())
-                continue;
-        }
+                arena.release();
 
-        //2D id of the vertex based on its x and z values and grouped by group size.
-        Vector2Int id = Vector2Int((int) floor(verts[currentVertIndex].x / groupSize),
-                                   (int) floor(verts[currentVertIndex].z / groupSize));
+                total_time += time;
 
-        vector<int> toCheck = vector<int>();
-        for (int x = -1; x <= 1; x++) {
-            for (int y = -1; y <= 1; y++) {
-                Vector2Int d = Vector2Int(id.x + x, id.y + y);
-                if (vertsByPos.find(d) != vertsByPos.end())
-                    toCheck.insert(toCheck.end(), vertsByPos[d].begin(), vertsByPos[d].end());
+                allOptimized.individualTime.push_back((float) time);
+                allOptimized.vertexCount.push_back((int) navMeshOptimized.getVertices().size());
+                allOptimized.indicesCount.push_back((int) navMeshOptimized.getIndices().size());
+                allOptimized.triangleCount.push_back((int) navMeshOptimized.getTriangles().size());
             }
-        }
-
-        for (const int &other: toCheck) {
-            if (other == currentVertIndex)
-                continue;
-
-            int i = (int) floor((float) other / groupSize);
 
-            if (removed.find(i) != removed.end())
-                if (find(removed[i].begin(), removed[i].end(), other) != removed[i].end())
-                    continue;
-
-            if (Vector3::Distance(verts[currentVertIndex], verts[other]) > overlapCheckDistance)
-                continue;
-
-            if (removed.find(i) == removed.end()) {
-                removed.insert({i, vector<int>()});
-            }
+            cout << "Vertex count match: "
+                 << (((int) navMeshOptimized.getVertices().size()) == navMeshImport.FV())
+                 << " | " << navMeshImport.FV() - ((int) navMeshOptimized.getVertices().size()) << "\n";
+            cout << "Indices count match: "
+                 << (((int) navMeshOptimized.getIndices().size()) == navMeshImport.FI())
+                 << " | " << navMeshImport.FI() - ((int) navMeshOptimized.getIndices().size()) << "\n";
+            cout << "Triangle count match: "
+                 << (((int) navMeshOptimized.getTriangles().size()) == navMeshImport.FT())
+                 << " | " << navMeshImport.FT() - ((int) navMeshOptimized.getTriangles().size()) << "\n\n";
+
+            cout << "Final vertex count: " << navMeshOptimized.getVertices().size() << "\n";
+            cout << "Final indices count: " << navMeshOptimized.getIndices().size() << "\n";
+            cout << "Final triangle count: " << navMeshOptimized.getTriangles().size() << "\n";
+            cout << "Non-manifold edges: " << navMeshOptimized.getNonManifoldEdges().size() << "\n";
+            cout << "Islands: " << navMeshOptimized.getIslandSizes().size() << " | Kept: "
+                 << navMeshOptimized.getKeptIslands().size() << "\n\n";
 
+            cout << "Repeat count: " << averageCount << "\n";
 
-            removed[i].push_back(other);
+            cout << "Total time for repeats: " << total_time << "(ms)\n";
+            cout << "Total time for repeats: " << total_time / 1000.0 << "(s)\n";
 
-            for (int &index: indices)
-                if (index == other)
-                    index = currentVertIndex;
-        }
-    }
+            cout << "Average time for " << name << ": " << total_time / averageCount << "(ms)\n";
+            cout << "Average time for " << name << ": " << total_time / averageCount / 1000.0 << "(s)\n\n";
 
-    vector<int> toRemove = vector<int>();
-    for (const pair<const int, vector<int>> &pair: removed) {
-        const vector<int> v = removed[pair.first];
-        toRemove.insert(toRemove.end(), v.begin(), v.end());
-    }
+            allOptimized.totalTime = (float) total_time;
 
-    sort(toRemove.begin(), toRemove.end(), greater());
+            fs::path fileName = root_path / "CppResults" / (name + ".csv");
 
-    for (const int &index: toRemove) {
-        const Vector3 v = verts[index];
-        Vector2Int l = Vector2Int((int) floor(v.x / groupSize),
-                                  (int) floor(v.z / groupSize));
+            writeCsv(fileName, allOptimized);
 
-        vector<int> by = vertsByPos[l];
-        for (int j = (int) by.size() - 1; j >= 0; --j) {
-            if (by[j] == index)
-                by.erase(by.begin() + j);
+            //Built with CPPOPTIMIZER_PROFILE, the stages of every repeat are written next to the results.
+            if (Profiler::enabled) {
+                Profiler::WriteStageCsv(root_path / "CppResults" / (name + " stages.csv"));
+                Profiler::WriteChromeTrace(root_path / "CppResults" / (name + " trace.json"));
+            }
         }
-
-        verts.erase(verts.begin() + index);
-
-        for (int &i: indices)
-            if (i >= index)
-                i = i - 1;
     }
 
-    for (int i = (int) indices.size() - 3; i >= 0; i -= 3) {
-        if (indices[i] == indices[i + 1] || indices[i] == indices[i + 2] ||
-            indices[i + 1] == indices[i + 2] ||
-            indices[i] >= (int) verts.size() || indices[i + 1] >= (int) verts.size() ||
-            indices[i + 2] >= (int) verts.size()) {
-
-            indices.erase(indices.begin() + i);
-            indices.erase(indices.begin() + i);
-            indices.erase(indices.begin() + i);
-        }
-    }
+    return 0;
 }
 
-void FillHoles(vector<Vector3> &verts, vector<int> &indices) {
-    vector<vector<int>> connectionsByIndex = vector<vector<int>>();
-    connectionsByIndex.reserve(verts.size());
-    vector<vector<int>> indicesByIndex = vector<vector<int>>();
-    indicesByIndex.reserve(verts.size());
-    for (int i = 0; i < (int) verts.size(); i++) {
-        connectionsByIndex.emplace_back(8);
-        indicesByIndex.emplace_back(8);
-    }
-
-    for (int i = 0; i < (int) indices.size(); i += 3) {
-
-        vector<int> check = connectionsByIndex[indices[i]];
-        if (find(check.begin(), check.end(), indices[i + 1]) == check.end())
-            connectionsByIndex[indices[i]].push_back(indices[i + 1]);
-        if (find(check.begin(), check.end(), indices[i + 2]) == check.end())
-            connectionsByIndex[indices[i]].push_back(indices[i + 2]);
-
-        check = connectionsByIndex[indices[i + 1]];
-        if (find(check.begin(), check.end(), indices[i]) == check.end())
-            connectionsByIndex[indices[i + 1]].push_back(indices[i]);
-        if (find(check.begin(), check.end(), indices[i + 2]) == check.end())
-            connectionsByIndex[indices[i + 1]].push_back(indices[i + 2]);
-
-        check = connectionsByIndex[indices[i + 2]];
-        if (find(check.begin(), check.end(), indices[i + 1]) == check.end())
-            connectionsByIndex[indices[i + 2]].push_back(indices[i + 1]);
-        if (find(check.begin(), check.end(), indices[i]) == check.end())
-            connectionsByIndex[indices[i + 2]].push_back(indices[i]);
-
-        vector<int> arr{indices[i], indices[i + 1], indices[i + 2]};
-
-        connectionsByIndex[indices[i]].insert(connectionsByIndex[indices[i]].end(), arr.begin(), arr.end());
-        connectionsByIndex[indices[i + 1]].insert(connectionsByIndex[indices[i + 1]].end(), arr.begin(), arr.end());
-        connectionsByIndex[indices[i + 2]].insert(connectionsByIndex[indices[i + 2]].end(), arr.begin(), arr.end());
-    }
-
-
-    for (int i = 0; i < (int) verts.size(); i++) {
-        Vector2 p = MathC::XZ(verts[i]);
-
-        for (int j = 0; j < (int) indices.size(); j += 3) {
-            if (indices[j] == i || indices[j + 1] == i || indices[j + 2] == i)
-                continue;
-
-            Vector2 a = MathC::XZ(verts[indices[j]]),
-                    b = MathC::XZ(verts[indices[j + 1]]),
-                    c = MathC::XZ(verts[indices[j + 2]]);
-
-            if (!MathC::PointWithinTriangle2DWithTolerance(p, a, b, c))
-                continue;
-
-            Vector2 close1 = MathC::ClosetPointOnLine(p, a, b),
-                    close2 = MathC::ClosetPointOnLine(p, a, c),
-                    close3 = MathC::ClosetPointOnLine(p, b, b);
-
-            Vector2 close = close3;
-            if (Vector2::Distance(close1, p) < Vector2::Distance(close2, p) &&
-                Vector2::Distance(close1, p) < Vector2::Distance(close3, p))
-                close = close1;
-            else if (Vector2::Distance(close2, p) < Vector2::Distance(close3, p))
-                close = close2;
-
-            Vector2 offset = close - p;
-            float mag = offset.Magnitude() + 0.01f;
-            offset.NormalizeSelf();
-            Vector2 moved = offset * mag;
-            Vector3 o = MathC::XYZ(moved);
-            verts[i] = verts[i] + o;
+#pragma region Batch
+
+struct BatchFileResult {
+    fs::path output;
+    int inputTriangles = 0, outputVertices = 0, outputTriangles = 0;
+    double milliseconds = 0;
+    string error;
+};
+
+/// <summary>
+///     Expands directories to the json and navbin files directly inside them, sorted by name. Results of earlier
+///     batch runs are skipped so a directory can be re-baked in place, and a json file is skipped when a navbin
+///     converted from it sits next to it, as both would write the same result.
+/// </summary>
+vector<fs::path> CollectBatchFiles(const vector<fs::path> &inputs) {
+    vector<fs::path> files = vector<fs::path>();
+
+    for (const fs::path &input: inputs) {
+        if (!fs::is_directory(input)) {
+            files.push_back(input);
+            continue;
         }
-    }
-
-    for (int original = 0; original < (int) verts.size(); original++) {
-        vector<int> originalConnections = connectionsByIndex[original];
-        int s = (int) originalConnections.size();
-
-        for (int otherIndex = 0; otherIndex < s; otherIndex++) {
-            int other = originalConnections[otherIndex];
 
-            if (other <= original)
+        vector<fs::path> found = vector<fs::path>();
+        for (const fs::directory_entry &entry: fs::directory_iterator(input)) {
+            const fs::path &path = entry.path();
+            if (!entry.is_regular_file() || (path.extension() != ".json" && path.extension() != ".navbin"))
                 continue;
-
-            for (int finalIndex = otherIndex + 1; finalIndex < s; finalIndex++) {
-                int final = originalConnections[finalIndex];
-
-                if (final <= original || final <= other)
-                    continue;
-
-                vector<int> v = connectionsByIndex[final];
-                if (find(v.begin(), v.end(), other) == v.end())
-                    continue;
-
-                bool denied = false;
-
-                Vector2 a = MathC::XZ(verts[original]),
-                        b = MathC::XZ(verts[other]),
-                        c = MathC::XZ(verts[final]);
-
-                Vector2 center = Vector2::Lerp(Vector2::Lerp(a, b, .5f), c, .5f);
-
-                float minX = MathC::Min(MathC::Min(a.x, b.x), c.x),
-                        minY = MathC::Min(MathC::Min(a.y, b.y), c.y),
-                        maxX = MathC::Max(MathC::Max(a.x, b.x), c.x),
-                        maxY = MathC::Max(MathC::Max(a.y, b.y), c.y);
-
-                for (int x = 0; x < (int) indices.size(); x += 3) {
-                    array checkArr = {indices[x], indices[x + 1], indices[x + 2]};
-
-
-                    if ((checkArr[0] == original || checkArr[1] == original || checkArr[2] == original) &&
-                        (checkArr[0] == other || checkArr[1] == other || checkArr[2] == other) &&
-                        (checkArr[0] == final || checkArr[1] == final || checkArr[2] == final)) {
-                        //The triangle already exists
-                        denied = true;
-                        break;
-                    }
-
-                    Vector2 aP = MathC::XZ(verts[checkArr[0]]),
-                            bP = MathC::XZ(verts[checkArr[1]]),
-                            cP = MathC::XZ(verts[checkArr[2]]);
-
-                    //Bounding
-                    if (maxX < MathC::Min(MathC::Min(aP.x, bP.x), cP.x))
-                        continue;
-                    if (maxY < MathC::Min(MathC::Min(aP.y, bP.y), cP.y))
-                        continue;
-                    if (minX > MathC::Max(MathC::Max(aP.x, bP.x), cP.x))
-                        continue;
-                    if (minY > MathC::Max(MathC::Max(aP.y, bP.y), cP.y))
-                        continue;
-
-                    //One of the new triangle points is within an already existing triangle
-                    if (MathC::PointWithinTriangle2DWithTolerance(center, aP, bP, cP)) {
-                        denied = true;
-                        break;
-                    }
-                    if (MathC::PointWithinTriangle2DWithTolerance(a, aP, bP, cP)) {
-                        denied = true;
-                        break;
-                    }
-                    if (MathC::PointWithinTriangle2DWithTolerance(b, aP, bP, cP)) {
-                        denied = true;
-                        break;
-                    }
-                    if (MathC::PointWithinTriangle2DWithTolerance(c, aP, bP, cP)) {
-                        denied = true;
-                        break;
-                    }
-
-                    if (!MathC::TriangleIntersect2D(a, b, c, aP, bP, cP))
-                        continue;
-
-                    denied = true;
-                    break;
-                }
-
-                if (denied)
-                    continue;
-
-                array arr = {original, other, final};
-                indices.insert(indices.end(), arr.begin(), arr.end());
-            }
-        }
-    }
-}
-
-void SetupNavTriangles(const vector<int> &indices, vector<NavMeshTriangle> &triangles,
-                       map<int, vector<int>> &trianglesByVertexID) {
-    for (int i = 0; i < (int) indices.size(); i += 3) {
-        int a = indices[i], b = indices[i + 1], c = indices[i + 2];
-        NavMeshTriangle triangle = NavMeshTriangle(i / 3, a, b, c);
-
-        triangles.push_back(triangle);
-
-        int tID = (int) triangles.size() - 1;
-
-        if (trianglesByVertexID.find(a) == trianglesByVertexID.end())
-            trianglesByVertexID.insert({a, vector<int>()});
-
-        if (trianglesByVertexID.find(b) == trianglesByVertexID.end())
-            trianglesByVertexID.insert({b, vector<int>()});
-
-        if (trianglesByVertexID.find(c) == trianglesByVertexID.end())
-            trianglesByVertexID.insert({c, vector<int>()});
-
-        trianglesByVertexID[a].push_back(tID);
-        trianglesByVertexID[b].push_back(tID);
-        trianglesByVertexID[c].push_back(tID);
-    }
-}
-
-void SetupNeighbors(vector<NavMeshTriangle> &triangles,
-                    map<int, vector<int>> &trianglesByVertexID) {
-    for (int i = 0; i < (int) triangles.size(); i++) {
-        vector<int> neighbors = vector<int>();
-        vector<int> possibleNeighbors = vector<int>();
-
-        possibleNeighbors.insert(possibleNeighbors.end(), trianglesByVertexID[triangles[i].vertices()[0]].begin(),
-                                 trianglesByVertexID[triangles[i].vertices()[0]].end());
-        possibleNeighbors.insert(possibleNeighbors.end(), trianglesByVertexID[triangles[i].vertices()[1]].begin(),
-                                 trianglesByVertexID[triangles[i].vertices()[1]].end());
-        possibleNeighbors.insert(possibleNeighbors.end(), trianglesByVertexID[triangles[i].vertices()[2]].begin(),
-                                 trianglesByVertexID[triangles[i].vertices()[2]].end());
-
-        for (const int &t: possibleNeighbors) {
-            if (t == i)
+            if (path.stem().extension() == ".optimized")
                 continue;
-
-            if (find(neighbors.begin(), neighbors.end(), t) != neighbors.end())
+            if (path.extension() == ".json" && fs::exists(fs::path(path).replace_extension(".navbin")))
                 continue;
 
-            if (SharedBetween(triangles[i].vertices(), triangles[t].vertices()).size() == 2)
-                neighbors.push_back(t);
+            found.push_back(entry.path());
         }
 
-        triangles[i].SetNeighborIds(neighbors);
-    }
-}
-
-vector<int> SharedBetween(const vector<int> &v1, const vector<int> &v2) {
-    vector<int> result = vector<int>();
-    result.reserve(2);
-    for (const auto &item1: v1) {
-        for (const auto &item2: v2) {
-            if (item1 == item2) {
-                result.push_back(item1);
-                continue;
-            }
-        }
+        sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
     }
 
-    return result;
+    return files;
 }
 
+int RunBatch(const vector<fs::path> &inputs, ThreadPool &pool, const bool binary,
+             const int minIslandTriangles, const HoleFillMode holeFillMode, const bool decimate) {
+    const float bucketCellSize = DefaultPolicy::groupSize;
 
-int main() {
-    cout << setprecision(8);
-    const int averageCount = 1000;
-
-    const vector<string> file_letter = {"S", "M", "L"};
-
-    const fs::path folder_path = fs::current_path().parent_path().parent_path() += "\\JsonFiles\\";
-    cout << "Using json text files from folder:\n" << folder_path << "\n";
-
-    for (int letter_index = 0; letter_index < 3; ++letter_index) {
-        for (int number_index = 1; number_index <= 5; ++number_index) {
-
-            cout << "Optimization for: " << file_letter[letter_index] << " " << number_index << '\n';
-
-            fs::path fileName = fs::current_path().parent_path().parent_path() +=
-                                        "\\JsonFiles\\" +
-                                        file_letter[letter_index] +
-                                        " " + to_string(number_index) +
-                                        ".txt";
+    vector<fs::path> files = CollectBatchFiles(inputs);
+    if (files.empty()) {
+        cout << "No mesh files found\n" << usage;
+        return 1;
+    }
 
-            NavMeshImport navMeshImport = loadJsonToNavMeshImport(fileName);
+    cout << "Batch optimizing " << files.size() << " files\n";
 
-            long long total_time = 0;
-            OptimizedResult allOptimized = OptimizedResult(averageCount);
-
-            for (int i = 0; i < averageCount; ++i) {
+    vector<BatchFileResult> results = vector<BatchFileResult>(files.size());
+    mutex logMutex;
 
-                cout << "Check " << to_string(i + 1) << "\n";
+    auto batchStart = high_resolution_clock::now();
 
-                cout << "Start vertex count: " << navMeshImport.getVertices().size() << "\n";
-                cout << "Start indices count: " << navMeshImport.getIndices().size() << "\n\n";
+    //Every file is one chunk so idle threads pick up the next file. The meshes themselves are optimized on a
+    //single thread each, as the files already keep every thread busy.
+    ThreadPool::ParallelFor(&pool, (int) files.size(), 1, [&](int begin, int end, int) {
+        for (int i = begin; i < end; i++) {
+            BatchFileResult &result = results[i];
+            result.output = fs::path(files[i]).replace_extension(binary ? ".optimized.navbin" : ".optimized.json");
 
+            try {
+                NavMeshImport navMeshImport = loadNavMeshImport(files[i], false);
                 const Vector3 cleanPoint = Vector3(navMeshImport.getCleanPoint()[0],
                                                    navMeshImport.getCleanPoint()[1],
                                                    navMeshImport.getCleanPoint()[2]);
 
-                vector<Vector3> vertices = vector<Vector3>();
-                for (Vector3 vertex: navMeshImport.getVertices()) {
-                    vertices.emplace_back(vertex.x, vertex.y, vertex.z);
-                }
-
-                vector<int> indices = vector<int>();
-                for (int index: navMeshImport.getIndices())
-                    indices.push_back(index);
+                NavMeshData mesh = NavMeshData(navMeshImport.getVertices(), navMeshImport.getIndices());
+                result.inputTriangles = mesh.TriangleCount();
 
                 auto timerStart = high_resolution_clock::now();
+                NavMeshOptimized navMeshOptimized = OptimizeNavMesh(cleanPoint, mesh, nullptr, minIslandTriangles,
+                                                                    nullptr, holeFillMode, decimate);
+                result.milliseconds = duration<double, milli>(high_resolution_clock::now() - timerStart).count();
+
+                NavMeshData &optimized = navMeshOptimized.getMesh();
+                result.outputVertices = optimized.VertexCount();
+                result.outputTriangles = optimized.TriangleCount();
+
+                if (binary)
+                    NavMeshBinary::Write(result.output, navMeshImport.getCleanPoint(), optimized,
+                                         optimized.VertexCount(), (int) optimized.indices.size(),
+                                         optimized.TriangleCount(), true, bucketCellSize,
+                                         &navMeshOptimized.getHierarchy());
+                else
+                    writeOptimizedJson(result.output, navMeshImport.getCleanPoint(), navMeshOptimized);
+            }
+            catch (const exception &e) {
+                result.error = e.what();
+            }
 
-                NavMeshOptimized navMeshOptimized = OptimizeNavMesh(cleanPoint, vertices, indices);
-
-                auto timerEnd = high_resolution_clock::now();
-
-                auto time = duration_cast<milliseconds>(timerEnd - timerStart);
+            lock_guard<mutex> lock(logMutex);
+            if (result.error.empty())
+                cout << "   " << files[i] << ": " << result.inputTriangles << " -> " << result.outputTriangles
+                     << " triangles in " << result.milliseconds << "(ms)\n";
+            else
+                cout << "   " << files[i] << ": failed, " << result.error << "\n";
+        }
+    });
 
-                allOptimized.vertexCount.push_back((int) navMeshOptimized.getVertices().size());
-                allOptimized.indicesCount.push_back((int) navMeshOptimized.getIndices().size());
-                allOptimized.triangleCount.push_back((int) navMeshOptimized.getTriangles().size());
+    double wallSeconds = duration<double>(high_resolution_clock::now() - batchStart).count();
 
-                total_time += time.count();
-
-                cout << "Vertex count match: "
-                     << (((int) navMeshOptimized.getVertices().size()) == navMeshImport.FV())
-                     << " | " << navMeshImport.FV() - ((int) navMeshOptimized.getVertices().size()) << "\n";
-                cout << "Indices count match: "
-                     << (((int) navMeshOptimized.getIndices().size()) == navMeshImport.FI())
-                     << " | " << navMeshImport.FI() - ((int) navMeshOptimized.getIndices().size()) << "\n";
-                cout << "Triangle count match: "
-                     << (((int) navMeshOptimized.getTriangles().size()) == navMeshImport.FT())
-                     << " | " << navMeshImport.FT() - ((int) navMeshOptimized.getTriangles().size()) << "\n\n";
-
-                cout << "Final vertex count: " << navMeshOptimized.getVertices().size() << "\n";
-                cout << "Final indices count: " << navMeshOptimized.getIndices().size() << "\n";
-                cout << "Final triangle count: " << navMeshOptimized.getTriangles().size() << "\n";
-                cout << "Time: " << time.count() << "(ms)\n";
-                cout << "Time: " << (float) time.count() / 1000.0f << "(s)\n\n";
-
-                allOptimized.individualTime.push_back((float) time.count());
-                allOptimized.vertexCount.push_back((int) navMeshOptimized.getVertices().size());
-                allOptimized.indicesCount.push_back((int) navMeshOptimized.getIndices().size());
-                allOptimized.triangleCount.push_back((int) navMeshOptimized.getTriangles().size());
-            }
+    int succeeded = 0;
+    long long inputTriangles = 0, outputTriangles = 0;
+    double optimizeMilliseconds = 0;
+    for (const BatchFileResult &result: results) {
+        if (!result.error.empty())
+            continue;
 
-            cout << "Repeat count: " << averageCount << "\n";
+        succeeded++;
+        inputTriangles += result.inputTriangles;
+        outputTriangles += result.outputTriangles;
+        optimizeMilliseconds += result.milliseconds;
+    }
 
-            cout << "Total time for repeats: " << total_time << "(ms)\n";
-            cout << "Total time for repeats: " << total_time / 1000 << "(s)\n";
+    cout << "\nOptimized " << succeeded << " of " << files.size() << " files\n";
+    cout << "Input triangles: " << inputTriangles << " | Output triangles: " << outputTriangles << "\n";
+    cout << "Wall time: " << wallSeconds << "(s) | Summed optimize time: " << optimizeMilliseconds / 1000.0
+         << "(s)\n";
+    cout << "Throughput: " << (double) succeeded / wallSeconds << " meshes/s | "
+         << (double) inputTriangles / wallSeconds << " triangles/s\n";
 
-            cout << "Average time for " << file_letter[letter_index] << " " << number_index << ": "
-                 << total_time / averageCount << "(ms)\n";
-            cout << "Average time for " << file_letter[letter_index] << " " << number_index << ": "
-                 << (float) total_time / (float) averageCount / 1000.0f << "(s)\n\n";
+    return succeeded == (int) files.size() ? 0 : 1;
+}
 
-            allOptimized.totalTime = (float) total_time;
+#pragma endregion
 
-            fileName = fs::current_path().parent_path().parent_path() +=
-                    "\\CppResults\\" +
-                    file_letter[letter_index] +
-                    " " + to_string(number_index) +
-                    ".csv";
+void writeOptimizedJson(const fs::path &fileName, const vector<float> &cleanPoint, NavMeshOptimized &optimized) {
+    const NavMeshData &mesh = optimized.getMesh();
 
-            writeCsv(fileName, allOptimized);
-        }
+    //Same layout as the input files so results can be fed back in, plus the three neighbor ids per triangle.
+    vector<int> neighbors = vector<int>();
+    neighbors.reserve(mesh.triangles.size() * 3);
+    for (const NavMeshTriangle &triangle: mesh.triangles) {
+        for (int i = 0; i < 3; i++)
+            neighbors.push_back(i < triangle.neighborCount() ? triangle.neighbor(i) : -1);
     }
 
-    return 0;
+    json js = json();
+    js["cleanPoint"] = {{"x", cleanPoint[0]}, {"y", cleanPoint[1]}, {"z", cleanPoint[2]}};
+    js["x"] = mesh.x;
+    js["y"] = mesh.y;
+    js["z"] = mesh.z;
+    js["indices"] = mesh.indices;
+    js["neighbors"] = neighbors;
+    js["finalVertexCount"] = mesh.VertexCount();
+    js["finalIndicesCount"] = mesh.indices.size();
+    js["finalTriangleCount"] = mesh.TriangleCount();
+
+    ofstream file(fileName);
+    if (!file)
+        throw runtime_error("could not write " + fileName.string());
+    file << js;
 }
 
 void writeCsv(fs::path &fileName, OptimizedResult &r) {